@@ -31,8 +31,34 @@
 #include "enums/Type.hpp"
 #include "utils/coretypes.h"
 
+#include <array>
+#include <span>
+#include <type_traits>
+
 namespace pksm
 {
+    // Every field of a personal record, decoded at once. Abilities that a generation does not
+    // have (hidden abilities before Gen 5) are Ability::None.
+    struct PersonalEntry
+    {
+        u8 baseHP;
+        u8 baseAtk;
+        u8 baseDef;
+        u8 baseSpe;
+        u8 baseSpa;
+        u8 baseSpd;
+        Type type1;
+        Type type2;
+        u8 gender;
+        u8 baseFriendship;
+        u8 expType;
+        u8 formCount;
+        u16 formStatIndex;
+        std::array<Ability, 3> abilities;
+    };
+
+    static_assert(std::is_trivially_copyable_v<PersonalEntry>);
+
     namespace PersonalLGPE
     {
         [[nodiscard]] u8 baseHP(u16 formSpecies);
@@ -49,6 +75,10 @@ namespace pksm
         [[nodiscard]] Ability ability(u16 formSpecies, u8 n);
         [[nodiscard]] u16 formStatIndex(u16 formSpecies);
         [[nodiscard]] u8 formCount(u16 formSpecies);
+        [[nodiscard]] PersonalEntry entry(u16 formSpecies);
+        // Decodes one record per formSpecies into out, stopping when either runs out, and returns
+        // how many were decoded
+        size_t entries(std::span<const u16> formSpecies, std::span<PersonalEntry> out);
     }
 
     namespace PersonalSMUSUM
@@ -67,6 +97,10 @@ namespace pksm
         [[nodiscard]] Ability ability(u16 formSpecies, u8 n);
         [[nodiscard]] u16 formStatIndex(u16 formSpecies);
         [[nodiscard]] u8 formCount(u16 formSpecies);
+        [[nodiscard]] PersonalEntry entry(u16 formSpecies);
+        // Decodes one record per formSpecies into out, stopping when either runs out, and returns
+        // how many were decoded
+        size_t entries(std::span<const u16> formSpecies, std::span<PersonalEntry> out);
     }
 
     namespace PersonalXYORAS
@@ -85,6 +119,10 @@ namespace pksm
         [[nodiscard]] Ability ability(u16 formSpecies, u8 n);
         [[nodiscard]] u16 formStatIndex(u16 formSpecies);
         [[nodiscard]] u8 formCount(u16 formSpecies);
+        [[nodiscard]] PersonalEntry entry(u16 formSpecies);
+        // Decodes one record per formSpecies into out, stopping when either runs out, and returns
+        // how many were decoded
+        size_t entries(std::span<const u16> formSpecies, std::span<PersonalEntry> out);
     }
 
     namespace PersonalBWB2W2
@@ -103,6 +141,10 @@ namespace pksm
         [[nodiscard]] Ability ability(u16 formSpecies, u8 n);
         [[nodiscard]] u16 formStatIndex(u16 formSpecies);
         [[nodiscard]] u8 formCount(u16 formSpecies);
+        [[nodiscard]] PersonalEntry entry(u16 formSpecies);
+        // Decodes one record per formSpecies into out, stopping when either runs out, and returns
+        // how many were decoded
+        size_t entries(std::span<const u16> formSpecies, std::span<PersonalEntry> out);
     }
 
     namespace PersonalDPPtHGSS
@@ -121,6 +163,10 @@ namespace pksm
         [[nodiscard]] Ability ability(u16 formSpecies, u8 n);
         [[nodiscard]] u16 formStatIndex(u16 formSpecies);
         [[nodiscard]] u8 formCount(u16 formSpecies);
+        [[nodiscard]] PersonalEntry entry(u16 formSpecies);
+        // Decodes one record per formSpecies into out, stopping when either runs out, and returns
+        // how many were decoded
+        size_t entries(std::span<const u16> formSpecies, std::span<PersonalEntry> out);
     }
 
     namespace PersonalSWSH
@@ -139,6 +185,10 @@ namespace pksm
         [[nodiscard]] Ability ability(u16 formSpecies, u8 n);
         [[nodiscard]] u16 formStatIndex(u16 formSpecies);
         [[nodiscard]] u8 formCount(u16 formSpecies);
+        [[nodiscard]] PersonalEntry entry(u16 formSpecies);
+        // Decodes one record per formSpecies into out, stopping when either runs out, and returns
+        // how many were decoded
+        size_t entries(std::span<const u16> formSpecies, std::span<PersonalEntry> out);
         [[nodiscard]] u16 pokedexIndex(u16 formSpecies);
         [[nodiscard]] u16 armordexIndex(u16 species);
         [[nodiscard]] u16 crowndexIndex(u16 species);
@@ -160,6 +210,10 @@ namespace pksm
         [[nodiscard]] u8 expType(u16 formSpecies);
         [[nodiscard]] Ability ability(u16 formSpecies, u8 n);
         [[nodiscard]] u8 formCount(u16 formSpecies);
+        [[nodiscard]] PersonalEntry entry(u16 formSpecies);
+        // Decodes one record per formSpecies into out, stopping when either runs out, and returns
+        // how many were decoded
+        size_t entries(std::span<const u16> formSpecies, std::span<PersonalEntry> out);
     }
 
     namespace PersonalGSC
@@ -292,6 +292,8 @@ namespace pksm
 
     private:
         [[nodiscard]] u16 statImpl(Stat stat) const override;
+        // statImpl with the personal record and level already fetched
+        [[nodiscard]] u16 statImpl(Stat stat, const PersonalEntry& personal, u8 lvl) const override;
     };
 }
 
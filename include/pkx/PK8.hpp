@@ -326,6 +326,8 @@ namespace pksm
 
     private:
         u16 statImpl(Stat stat) const override;
+        // statImpl with the personal record and level already fetched
+        u16 statImpl(Stat stat, const PersonalEntry& personal, u8 lvl) const override;
     };
 }
 
@@ -39,7 +39,9 @@
 #include "pkx/IPKFilterable.hpp"
 #include <array>
 #include <bitset>
+#include <memory>
 #include <string>
+#include <vector>
 
 #define MAKE_DEFN(name, type)                                                                      \
 public:                                                                                            \
@@ -169,6 +171,84 @@ private:
     std::bitset<amount> name##Bool      = std::bitset<amount>(0);                                  \
     std::bitset<amount> name##Inverse   = std::bitset<amount>(0)
 
+// Passes when the value is one of those added. Adding none disables the check
+#define MAKE_SET_DEFN(name, type, amount)                                                          \
+public:                                                                                            \
+    [[nodiscard]] bool name##In(type v) const                                                      \
+    {                                                                                              \
+        return size_t(v) < amount && name##Bits[size_t(v)];                                        \
+    }                                                                                              \
+    void name##In(type v, bool in)                                                                 \
+    {                                                                                              \
+        if (size_t(v) < amount)                                                                    \
+        {                                                                                          \
+            name##Bits[size_t(v)] = in;                                                            \
+        }                                                                                          \
+    }                                                                                              \
+    void name##InClear(void)                                                                       \
+    {                                                                                              \
+        name##Bits.reset();                                                                        \
+    }                                                                                              \
+    [[nodiscard]] const std::bitset<amount>& name##Values(void) const                              \
+    {                                                                                              \
+        return name##Bits;                                                                         \
+    }                                                                                              \
+    [[nodiscard]] bool name##InEnabled(void) const                                                 \
+    {                                                                                              \
+        return name##Bits.any();                                                                   \
+    }                                                                                              \
+    [[nodiscard]] bool name##InInversed(void) const                                                \
+    {                                                                                              \
+        return name##InInverse;                                                                    \
+    }                                                                                              \
+    void name##InInversed(bool v)                                                                  \
+    {                                                                                              \
+        name##InInverse = v;                                                                       \
+    }                                                                                              \
+                                                                                                   \
+private:                                                                                           \
+    std::bitset<amount> name##Bits = std::bitset<amount>(0);                                       \
+    bool name##InInverse           = false
+
+// Passes when min <= value <= max
+#define MAKE_RANGE_DEFN(name, type)                                                                \
+public:                                                                                            \
+    [[nodiscard]] type name##Min(void) const                                                       \
+    {                                                                                              \
+        return name##Low;                                                                          \
+    }                                                                                              \
+    [[nodiscard]] type name##Max(void) const                                                       \
+    {                                                                                              \
+        return name##High;                                                                         \
+    }                                                                                              \
+    void name##Range(type min, type max)                                                           \
+    {                                                                                              \
+        name##Low  = min;                                                                          \
+        name##High = max;                                                                          \
+    }                                                                                              \
+    [[nodiscard]] bool name##RangeEnabled(void) const                                              \
+    {                                                                                              \
+        return name##RangeBool;                                                                    \
+    }                                                                                              \
+    void name##RangeEnabled(bool v)                                                                \
+    {                                                                                              \
+        name##RangeBool = v;                                                                       \
+    }                                                                                              \
+    [[nodiscard]] bool name##RangeInversed(void) const                                             \
+    {                                                                                              \
+        return name##RangeInverse;                                                                 \
+    }                                                                                              \
+    void name##RangeInversed(bool v)                                                               \
+    {                                                                                              \
+        name##RangeInverse = v;                                                                    \
+    }                                                                                              \
+                                                                                                   \
+private:                                                                                           \
+    type name##Low          = type();                                                              \
+    type name##High         = type();                                                              \
+    bool name##RangeBool    = false;                                                               \
+    bool name##RangeInverse = false
+
 namespace pksm
 {
     class PKFilter : public IPKFilterable
@@ -192,6 +272,76 @@ namespace pksm
         MAKE_DEFN(language, Language);
         MAKE_DEFN(egg, bool);
         MAKE_NUM_DEFN(iv, u8, 6, Stat);
+
+        // For moves, passing means any of the four moves is in the set
+        MAKE_SET_DEFN(species, Species, 1024);
+        MAKE_SET_DEFN(heldItem, u16, 2048);
+        MAKE_SET_DEFN(ability, Ability, 512);
+        MAKE_SET_DEFN(move, Move, 1024);
+        MAKE_RANGE_DEFN(level, u8);
+    };
+
+    class PKX;
+
+    // The enabled checks of a PKFilter, flattened into a list that runs cheapest and most selective
+    // first. Compile once and reuse it when testing many Pokemon against the same filter. Later
+    // changes to the filter don't affect it
+    class CompiledPKFilter
+    {
+    public:
+        explicit CompiledPKFilter(const PKFilter& filter);
+
+        [[nodiscard]] bool matches(const PKX& pk) const;
+        // One bit per element of pks, set where it matches. Null elements never match
+        [[nodiscard]] std::vector<u64> matches(const std::vector<std::unique_ptr<PKX>>& pks) const;
+
+    private:
+        // Listed in the order they are evaluated
+        enum class Field : u8
+        {
+            Generation,
+            Species,
+            SpeciesSet,
+            AlternativeForm,
+            HeldItem,
+            HeldItemSet,
+            Move,
+            MoveSet,
+            RelearnMove,
+            Ability,
+            AbilitySet,
+            Ball,
+            Nature,
+            Iv,
+            Language,
+            Gender,
+            Egg,
+            TSV,
+            Shiny,
+            Level,
+            LevelRange
+        };
+        struct Check
+        {
+            Field field;
+            u8 index;
+            bool inverse;
+            u32 value;
+            // Upper bound of a range
+            u32 max;
+        };
+
+        std::array<Check, 13 + 4 + 4 + 6 + 5> checks;
+        std::bitset<1024> speciesSet;
+        std::bitset<2048> heldItemSet;
+        std::bitset<1024> moveSet;
+        std::bitset<512> abilitySet;
+        u8 count = 0;
+        // Relearn moves only exist from Gen VI onwards, and no earlier Pokemon can match a filter
+        // that checks them
+        bool needsRelearnMoves = false;
+        // The filter contradicts itself and nothing can match
+        bool impossible        = false;
     };
 }
 
@@ -199,5 +349,7 @@ namespace pksm
 #undef MAKE_DEFN_CONSTANT
 #undef MAKE_NUM_DEFN
 #undef MAKE_NUM_DEFN_CONSTANT
+#undef MAKE_SET_DEFN
+#undef MAKE_RANGE_DEFN
 
 #endif
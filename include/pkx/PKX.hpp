@@ -62,6 +62,7 @@ namespace pksm
     class PK7;
     class PK8;
     class PB7;
+    struct PersonalEntry;
 
     class PKX : public IPKFilterable
     {
@@ -88,6 +89,14 @@ namespace pksm
         PKX(u8* data, size_t length, bool directAccess = false);
 
         [[nodiscard]] u32 expTable(u8 row, u8 col) const;
+        // Level that experience() reaches with growth rate xpType
+        [[nodiscard]] u8 levelFromExp(u8 xpType) const;
+        // stat() with the personal record and level already fetched, for working out several
+        // stats at once
+        [[nodiscard]] u16 stat(Stat stat, const PersonalEntry& personal, u8 lvl) const
+        {
+            return fixedHP(stat) ? 1 : statImpl(stat, personal, lvl);
+        }
         virtual void reorderMoves(void);
 
         u32 length = 0;
@@ -147,6 +156,8 @@ namespace pksm
         PKX(PKX&& pk);
         PKX& operator=(const PKX& pk);
         PKX& operator=(PKX&& pk);
+        // Checks the filter's fields one by one. CompiledPKFilter is quicker when testing many
+        // Pokemon against the same filter
         [[nodiscard]] bool operator==(const PKFilter& filter) const;
 
         [[nodiscard]] virtual std::string_view extension(void) const = 0;
@@ -369,14 +380,7 @@ namespace pksm
         void shiny(bool v) override                       = 0;
         [[nodiscard]] virtual u16 formSpecies(void) const = 0;
 
-        [[nodiscard]] u16 stat(Stat stat) const
-        {
-            if (species() == Species::Shedinja && stat == Stat::HP)
-            {
-                return 1;
-            }
-            return statImpl(stat);
-        }
+        [[nodiscard]] u16 stat(Stat stat) const { return fixedHP(stat) ? 1 : statImpl(stat); }
 
         // Hehehehe... to be done
         // virtual u8 sleepTurns(void) const = 0;
@@ -428,7 +432,17 @@ namespace pksm
         [[nodiscard]] bool isFilter() const final { return false; }
 
     private:
+        // Shedinja always has 1 HP, whatever its base stats say
+        [[nodiscard]] bool fixedHP(Stat stat) const
+        {
+            return species() == Species::Shedinja && stat == Stat::HP;
+        }
         [[nodiscard]] virtual u16 statImpl(Stat stat) const = 0;
+        // Generations that keep their personal data in one record override this to skip the lookup
+        [[nodiscard]] virtual u16 statImpl(Stat stat, const PersonalEntry&, u8) const
+        {
+            return statImpl(stat);
+        }
     };
 }
 
@@ -0,0 +1,86 @@
+/*
+ *   This file is part of PKSM-Core
+ *   Copyright (C) 2016-2022 Bernardo Giordano, Admiral Fish, piepie62
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+ *       * Requiring preservation of specified reasonable legal notices or
+ *         author attributions in that material or in the Appropriate Legal
+ *         Notices displayed by works containing it.
+ *       * Prohibiting misrepresentation of the origin of that material,
+ *         or requiring that modified versions of such material be marked in
+ *         reasonable ways as different from the original version.
+ */
+
+#ifndef CLONEDETECTOR_HPP
+#define CLONEDETECTOR_HPP
+
+#include "sav/Sav.hpp"
+#include "utils/coretypes.h"
+#include <utility>
+#include <vector>
+
+namespace pksm
+{
+    // Finds Pokemon that appear more than once across any number of saves, each known by an ID
+    // chosen by the caller. Every Pokemon is reduced to two 64-bit fingerprints as it is added,
+    // and clusters are found by hashing those, so the cost grows linearly with the record count
+    class CloneDetector
+    {
+    public:
+        struct Record
+        {
+            u32 save;
+            Sav::StorageSlot where;
+        };
+
+        struct Cluster
+        {
+            // Every record holds the same bytes. Otherwise they share encryption constant, PID,
+            // TID and SID but differ elsewhere, such as a copy that was levelled up or renamed
+            bool exact;
+            std::vector<Record> records;
+        };
+
+        // Fingerprints every Pokemon in sav, party and boxes
+        void add(u32 save, const Sav& sav);
+        // Takes in the records of a detector that was run over another shard of saves
+        void merge(CloneDetector&& other);
+        [[nodiscard]] size_t size(void) const { return entries.size(); }
+
+        // Every group of two or more identical records, and every group of records that are the
+        // same individual but not all identical. A record can be in one of each
+        [[nodiscard]] std::vector<Cluster> clusters(void) const;
+
+        // Adds each save on the library executor and merges the results
+        [[nodiscard]] static CloneDetector scan(
+            const std::vector<std::pair<u32, const Sav*>>& saves);
+
+    private:
+        struct Entry
+        {
+            // Encryption constant, PID, TID and SID. Gen I and II have no such identity, so for
+            // them this is the body
+            u64 identity;
+            // The stored record without party-only data, checksum included
+            u64 body;
+            Record record;
+        };
+
+        std::vector<Entry> entries;
+    };
+}
+
+#endif
@@ -0,0 +1,110 @@
+/*
+ *   This file is part of PKSM-Core
+ *   Copyright (C) 2016-2022 Bernardo Giordano, Admiral Fish, piepie62, Pk11
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+ *       * Requiring preservation of specified reasonable legal notices or
+ *         author attributions in that material or in the Appropriate Legal
+ *         Notices displayed by works containing it.
+ *       * Prohibiting misrepresentation of the origin of that material,
+ *         or requiring that modified versions of such material be marked in
+ *         reasonable ways as different from the original version.
+ */
+
+#ifndef DECODEDSLOTS_HPP
+#define DECODEDSLOTS_HPP
+
+#ifndef _PKSMCORE_CONFIGURED
+#include "PKSMCORE_CONFIG.h"
+#endif
+
+#include "utils/coretypes.h"
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#ifndef _PKSMCORE_DISABLE_THREAD_SAFETY
+#include <mutex>
+#include <shared_mutex>
+#endif
+
+namespace pksm
+{
+    // Box records that Gen I and II saves assemble from several places, kept in their finished
+    // form so that reading a slot again is a single copy. Entries are built on first read; the
+    // save stays authoritative, so anything that writes a slot's bytes must invalidate it
+    class DecodedSlots
+    {
+    public:
+        void reset(size_t count, size_t length)
+        {
+            entryLength = length;
+            entries.assign(count * length, 0);
+            valid.assign(count, false);
+        }
+
+        // Copies entry index into out, calling build(entry) first if it isn't cached. Cached entries
+        // are read under a shared lock, so concurrent readers only wait on each other to build
+        template <typename Build>
+        void read(size_t index, u8* out, Build&& build)
+        {
+            u8* entry = &entries[index * entryLength];
+#ifndef _PKSMCORE_DISABLE_THREAD_SAFETY
+            {
+                std::shared_lock guard{lock};
+                if (valid[index])
+                {
+                    std::copy_n(entry, entryLength, out);
+                    return;
+                }
+            }
+            std::lock_guard guard{lock};
+#endif
+            if (!valid[index])
+            {
+                build(entry);
+                valid[index] = true;
+            }
+            std::copy_n(entry, entryLength, out);
+        }
+
+        void invalidate(size_t index)
+        {
+#ifndef _PKSMCORE_DISABLE_THREAD_SAFETY
+            std::lock_guard guard{lock};
+#endif
+            valid[index] = false;
+        }
+
+        void invalidateAll(void)
+        {
+#ifndef _PKSMCORE_DISABLE_THREAD_SAFETY
+            std::lock_guard guard{lock};
+#endif
+            std::fill(valid.begin(), valid.end(), false);
+        }
+
+    private:
+        size_t entryLength = 0;
+        std::vector<u8> entries;
+        std::vector<bool> valid;
+#ifndef _PKSMCORE_DISABLE_THREAD_SAFETY
+        std::shared_mutex lock;
+#endif
+    };
+}
+
+#endif
@@ -27,6 +27,10 @@
 #ifndef SAV_HPP
 #define SAV_HPP
 
+#ifndef _PKSMCORE_CONFIGURED
+#include "PKSMCORE_CONFIG.h"
+#endif
+
 #include "enums/Ability.hpp"
 #include "enums/Ball.hpp"
 #include "enums/GameVersion.hpp"
@@ -38,20 +42,28 @@
 #include "sav/Item.hpp"
 #include "utils/coretypes.h"
 #include "utils/DateTime.hpp"
+#include "utils/endian.hpp"
 #include "utils/SmallVector.hpp"
 #include "utils/VersionTables.hpp"
 #include "wcx/WCX.hpp"
+#include <functional>
+#include <future>
 #include <map>
 #include <memory>
 #include <set>
+#include <span>
 #include <type_traits>
 #include <vector>
 
+#ifndef _PKSMCORE_DISABLE_THREAD_SAFETY
+#include <atomic>
+#endif
+
 namespace pksm
 {
     class Sav
     {
-    protected:
+    public:
         enum class Game
         {
             DP,
@@ -72,7 +84,29 @@ namespace pksm
             Y,
             GS,
             C
-        } game;
+        };
+
+        // Reads size bytes at offset into out, returning false if they aren't available
+        using ByteSource = std::function<bool(size_t offset, u8* out, size_t size)>;
+
+        // What identify() can tell about a save without constructing it
+        struct SaveInfo
+        {
+            // A known format was found. Never set if truncated is
+            bool recognized = false;
+            // The data ran out before a decision could be made
+            bool truncated        = false;
+            Game game             = Game::RGB;
+            Generation generation = Generation::UNUSED;
+            // Only known up front for Gen I Japanese saves and Gen II saves
+            Language language = Language::None;
+            // Which of the two save copies is current for Gen III and the Gen IV general block,
+            // otherwise -1
+            int activePartition = -1;
+        };
+
+    protected:
+        Game game;
 
         int Box, Party, PokeDex, WondercardData, WondercardFlags;
         int PouchHeldItem, PouchKeyItem, PouchTMHM, PouchMedicine, PouchBerry;
@@ -80,11 +114,186 @@ namespace pksm
         const std::shared_ptr<u8[]> data;
         const u32 length;
         u32 fullLength;
-        [[nodiscard]] static std::unique_ptr<Sav> checkGBType(
-            const std::shared_ptr<u8[]>& dt, size_t length);
-        [[nodiscard]] static std::unique_ptr<Sav> checkGBAType(const std::shared_ptr<u8[]>& dt);
-        [[nodiscard]] static std::unique_ptr<Sav> checkDSType(const std::shared_ptr<u8[]>& dt);
+#ifdef _PKSMCORE_ENABLE_MMAP
+        // File the save was mapped from, if any
+        std::string mappedFrom;
+#endif
+        [[nodiscard]] static SaveInfo identifyDS(const ByteSource& source);
         [[nodiscard]] static bool validSequence(const std::shared_ptr<u8[]>& dt, size_t offset);
+        [[nodiscard]] static bool validSequence(const ByteSource& source, size_t offset);
+
+        [[nodiscard]] static ByteSource bufferSource(const u8* data, size_t size);
+
+        // The part of finishEditing that has to be done to the save itself, done by
+        // finishEditingAsync before copying it. Must leave the save ready for editing
+        virtual void prepareImage(void) {}
+        // The rest of finishEditing, applied to image, a copy of data taken after prepareImage.
+        // Runs while editing carries on, so it must not touch data or anything else that changes
+        virtual void finishImage(const std::shared_ptr<u8[]>& image) const = 0;
+
+        // Missing bytes read as zero
+        template <typename T>
+        [[nodiscard]] static T readSource(const ByteSource& source, size_t offset)
+        {
+            u8 buffer[sizeof(T)] = {};
+            source(offset, buffer, sizeof(T));
+            return LittleEndian::convertTo<T>(buffer);
+        }
+
+    public:
+        // Identifies a storage slot. Party slots use PARTY as their box
+        struct StorageSlot
+        {
+            static constexpr u8 PARTY = 0xFF;
+
+            u8 box;
+            u8 slot;
+
+            [[nodiscard]] bool isParty(void) const { return box == PARTY; }
+        };
+
+        // pk is a view that is only valid for the duration of the call
+        using PKMVisitor = std::function<void(const PKX& pk, StorageSlot where)>;
+        // Returning true writes the changes made to pk back into the save
+        using PKMEditor = std::function<bool(PKX& pk, StorageSlot where)>;
+
+    protected:
+        struct StoredSlot
+        {
+            StorageSlot where;
+            // Start of the record in save memory, or nullptr if it isn't stored as a single
+            // contiguous PKX-format record, in which case pkm() is used instead. Box records are
+            // only read through this and written with writeBoxSlot
+            u8* raw;
+            u16 length;
+        };
+
+        // Every party slot in use followed by every box slot, in storage order
+        [[nodiscard]] virtual std::vector<StoredSlot> storageTable(void) const;
+        [[nodiscard]] std::unique_ptr<PKX> slotView(const StoredSlot& slot, u8* scratch) const;
+
+        // Box slot occupancy, one bit per slot. Built on first use and kept current by the box
+        // pkm() setters, which must call markSlot. Anything else that moves box data around has
+        // to call invalidateFreeSlots
+        mutable std::vector<u64> occupiedSlots;
+        [[nodiscard]] const std::vector<u64>& occupancy(void) const;
+        void markSlot(u8 box, u8 slot, bool occupied);
+        void invalidateFreeSlots(void) { occupiedSlots.clear(); }
+
+        // Pokedex flags of one available species
+        [[nodiscard]] virtual bool getSeen(Species species) const   = 0;
+        [[nodiscard]] virtual bool getCaught(Species species) const = 0;
+        // Sets the Pokedex flags for pk, leaving the cached counts to dex and dexAll
+        virtual void registerDex(const PKX& pk) = 0;
+        // Everything about pk that registerDex reads. Registering a species again with the key it
+        // was last registered with changes nothing, so dexAll skips those repeats
+        [[nodiscard]] virtual std::pair<u64, u32> dexKey(const PKX& pk) const;
+        // dexSeen and dexCaught as last counted, or -1. Counted on first use through
+        // cachedDexCount, kept current by dex() and forgotten when a snapshot is restored
+#ifdef _PKSMCORE_DISABLE_THREAD_SAFETY
+        using DexCount = int;
+#else
+        using DexCount = std::atomic<int>;
+#endif
+        mutable DexCount seenCount = -1, caughtCount = -1;
+        template <typename Count>
+        [[nodiscard]] static int cachedDexCount(DexCount& cache, Count&& count)
+        {
+            int ret = cache;
+            if (ret < 0)
+            {
+                ret   = count();
+                cache = ret;
+            }
+            return ret;
+        }
+        // Declared around every registerDex() made by dex(), so that the cached counts take in
+        // whatever flags it sets
+        class DexUpdate
+        {
+        public:
+            DexUpdate(const Sav& save, Species species);
+            ~DexUpdate();
+
+        private:
+            const Sav& save;
+            Species species;
+            bool available, seen, caught;
+        };
+
+        // Pages of the most recent snapshot taken or restored, which the next snapshot shares
+        // wherever data still matches them
+        std::vector<std::shared_ptr<const u8[]>> snapshotPages;
+        // Called before a snapshot is taken or restored, to get data into a form that says
+        // everything there is to know about the save. Must leave the save ready for editing
+        virtual void prepareSnapshot(void) {}
+        // State kept outside of data that snapshots have to carry
+        [[nodiscard]] virtual u32 snapshotState(void) const { return 0; }
+        virtual void restoreState(u32 /*state*/) {}
+
+        // Stable single-pass compaction of slots [0, count): occupied slots keep their order and
+        // end up at the front. occupied(i) is only asked about slots that haven't been moved yet,
+        // and swap(a, b) exchanges the stored data of two slots. Returns the occupied slot count
+        template <typename Occupied, typename Swap>
+        static int compactSlots(int count, Occupied&& occupied, Swap&& swap)
+        {
+            int write = 0;
+            for (int read = 0; read < count; read++)
+            {
+                if (occupied(read))
+                {
+                    if (read != write)
+                    {
+                        swap(write, read);
+                    }
+                    write++;
+                }
+            }
+            return write;
+        }
+
+        // Exchanges the raw records stored in two party slots. Used by fixParty
+        virtual void swapPartySlots(u8 a, u8 b);
+
+        // Number of usable slots in a box
+        [[nodiscard]] virtual u8 boxSlots(u8 box) const;
+        // Everything stored for one box slot, as a fixed-size blob. From Gen III on, the blob is
+        // the PKX record itself
+        [[nodiscard]] virtual u16 boxSlotSize(void) const;
+        virtual void readBoxSlot(u8 box, u8 slot, u8* out) const;
+        virtual void writeBoxSlot(u8 box, u8 slot, const u8* in);
+        // Called by sortBoxes once slots[i] holds what slots[order[i]] used to hold
+        virtual void boxSlotsMoved(
+            const std::vector<StorageSlot>& /*slots*/, const std::vector<size_t>& /*order*/)
+        {
+        }
+
+        struct SaveBlock
+        {
+            u32 id;
+            u32 offset;
+            u32 length;
+            // Where the save reads the block's bytes from, if it keeps a copy of them somewhere
+            // other than data + offset. nullptr means data + offset
+            const u8* raw = nullptr;
+        };
+        // The checksummed blocks the save is made of, which diffSaves compares before looking any
+        // closer. Blocks are matched up between saves by id, as some games move them around.
+        // Defaults to the whole save as one block
+        [[nodiscard]] virtual std::vector<SaveBlock> saveBlocks(void) const;
+        // Blocks numbered by their position in a pair of offset and length tables
+        template <typename Offset, typename Length, size_t N>
+        [[nodiscard]] static std::vector<SaveBlock> blocksFrom(
+            const Offset (&offsets)[N], const Length (&lengths)[N])
+        {
+            std::vector<SaveBlock> ret;
+            ret.reserve(N);
+            for (size_t i = 0; i < N; i++)
+            {
+                ret.push_back({u32(i), u32(offsets[i]), u32(lengths[i])});
+            }
+            return ret;
+        }
 
     public:
         enum class Pouch
@@ -113,26 +322,148 @@ namespace pksm
             FORM,
             ABILITY,
             ITEM,
-            BALL
+            BALL,
+            CONVERSION // No conversion exists from the Pokemon's format to this save's
+        };
+        struct TransferResult
+        {
+            BadTransferReason reason;
+            // Index (box * 30 + slot) the Pokemon was written to, or -1. A Pokemon that passed
+            // every check but found no free slot is left with reason OKAY and slot -1
+            int slot;
+        };
+        enum class SortKey
+        {
+            Species,
+            Form,
+            Level,
+            Nature,
+            Gender,
+            Ball,
+            Shiny,
+            TID,
+            Nickname,
+            OTName
+        };
+        struct SortCriterion
+        {
+            SortKey key;
+            bool descending = false;
+        };
+        // What changed between two versions of the same save, as found by diffSaves
+        struct Diff
+        {
+            enum class TrainerField
+            {
+                TID,
+                SID,
+                Name,
+                Gender,
+                Language,
+                Money,
+                BP,
+                Badges,
+                PlayTime,
+                CurrentBox
+            };
+            struct PKMChange
+            {
+                StorageSlot where;
+                Species before;
+                Species after;
+            };
+            // Total count of an item across its pouch
+            struct ItemChange
+            {
+                Pouch pouch;
+                u16 item;
+                u32 before;
+                u32 after;
+            };
+
+            // False if the saves aren't of the same game, in which case nothing else is filled in
+            bool comparable = true;
+            // Ids of the blocks whose contents differ. If there are none, nothing else is either
+            std::vector<u32> blocks;
+            std::vector<PKMChange> pkm;
+            std::vector<TrainerField> trainer;
+            std::vector<ItemChange> items;
+        };
+        // The contents of a save at some point, for undo and redo. Snapshots of the same save
+        // share the pages that didn't change between them
+        class Snapshot
+        {
+            friend class Sav;
+
+            const Sav* owner = nullptr;
+            std::vector<std::shared_ptr<const u8[]>> pages;
+            u32 state = 0;
+
+        public:
+            [[nodiscard]] bool valid(void) const { return owner != nullptr; }
         };
 
         virtual ~Sav() = default;
 
-        Sav(const std::shared_ptr<u8[]>& data, u32 length) : data(data), length(length) {}
+        Sav(const std::shared_ptr<u8[]>& data, u32 length)
+            : data(data), length(length), fullLength(length)
+        {
+        }
 
         Sav(const Sav& save)            = delete;
         Sav& operator=(const Sav& save) = delete;
+
+        // Const member functions may be called from several threads at once, provided nothing
+        // modifies the save meanwhile. The one exception is the occupancy index behind
+        // firstFreeSlot and freeSlots, which is built on first use: call one of them before
+        // sharing the save between threads. Everything non-const needs exclusive access
+
         // Readies the save for serialization in signed/encrypted form
         virtual void finishEditing(void) = 0;
         // Must be called to continue editing after calling finishEditing.
         // Not necessary directly after construction
         virtual void beginEditing(void) = 0;
+        // Does finishEditing's work on a copy of the save using the library executor, and returns
+        // the finished copy, footer included. The save itself is left ready for editing, which can
+        // carry on in the meantime. The save must outlive the returned future's result
+        [[nodiscard]] std::future<std::shared_ptr<u8[]>> finishEditingAsync(void);
+        // Captures the save as it is now. Only the pages written since the previous snapshot get
+        // copied; the rest are shared with it. Take snapshots while editing, not after
+        // finishEditing
+        [[nodiscard]] Snapshot snapshot(void);
+        // Puts the save back the way it was when snapshot was taken, writing only the pages that
+        // differ. Returns false if snapshot came from another save
+        bool restore(const Snapshot& snapshot);
 
         [[nodiscard]] BadTransferReason invalidTransferReason(const PKX& pk) const;
         [[nodiscard]] std::unique_ptr<PKX> transfer(const PKX& pk);
+        // Checks and converts every Pokemon in pks, then writes the ones that pass into free box
+        // slots in order, lowest index first. Returns one result per Pokemon, in the same order.
+        // Each source generation's TransferTable is looked up once for the whole batch, and if
+        // threads is greater than one the checks and conversions are split across the library
+        // executor. Each conversion is seeded with one draw from the calling thread's random
+        // number generator, and the generators of the threads that run them are left as they
+        // were, so after seedRand the results are the same for any number of threads
+        [[nodiscard]] std::vector<TransferResult> transferMany(
+            std::span<const PKX* const> pks, bool applyTrade, size_t threads = 1);
         [[nodiscard]] static bool isValidDSSave(const std::shared_ptr<u8[]>& dt);
         [[nodiscard]] static std::unique_ptr<Sav> getSave(
             const std::shared_ptr<u8[]>& dt, size_t length);
+        // Works out which game a save of the given total length belongs to, reading as few bytes as
+        // possible and without constructing anything
+        [[nodiscard]] static SaveInfo identify(const ByteSource& source, size_t length);
+        // available may be less than length, e.g. for just the start of a file
+        [[nodiscard]] static SaveInfo identify(const u8* data, size_t available, size_t length);
+        [[nodiscard]] static SaveInfo identify(int fd);
+#ifdef _PKSMCORE_ENABLE_MMAP
+        // Maps the save file privately, so only the pages that get used are read, and edits stay
+        // in memory until writeBack. Returns nullptr if the file can't be mapped or isn't a save
+        [[nodiscard]] static std::unique_ptr<Sav> getSave(const std::string& path);
+        // Writes only the pages that changed since loading to path, which must still hold the
+        // save as it was loaded (any other file gets compared page by page instead). Defaults to
+        // the file the save was mapped from. Call finishEditing first
+        [[nodiscard]] bool writeBack(const std::string& path = "") const;
+#endif
 
         [[nodiscard]] virtual u16 TID(void) const             = 0;
         virtual void TID(u16 v)                               = 0;
@@ -183,7 +514,11 @@ namespace pksm
             const Date& date = Date::today()) const = 0; // Look into bank boolean parameter
         [[nodiscard]] virtual std::unique_ptr<PKX> emptyPkm() const = 0;
 
-        virtual void dex(const PKX& pk)                                       = 0;
+        void dex(const PKX& pk);
+        // Registers every Pokemon in the party and boxes except eggs, in one pass over storage.
+        // A Pokemon that looks the same to the Pokedex as the last one of its species is skipped,
+        // and the seen and caught counts are redone once at the end
+        void dexAll(void);
         [[nodiscard]] virtual int dexSeen(void) const                         = 0;
         [[nodiscard]] virtual int dexCaught(void) const                       = 0;
         [[nodiscard]] virtual int currentGiftAmount(void) const               = 0;
@@ -198,12 +533,63 @@ namespace pksm
         virtual void partyCount(u8 count)                                     = 0;
         virtual void fixParty(void); // Has to be overridden by SavLGPE because it works stupidly
 
+        // Visits every occupied party slot, then every occupied box slot, in storage order. If
+        // threads is greater than one, the slots are split into that many parts that run on the
+        // library executor, and visitor must be safe to call concurrently. LGPE party members live
+        // in box storage, so they are only visited as box slots
+        void forEachPKM(const PKMVisitor& visitor, size_t threads = 1) const;
+        // Like forEachPKM, but for modifying Pokemon in place. editor must not add, remove, or move
+        // any Pokemon while iterating. The checksum of each Pokemon written back is refreshed
+        void editEachPKM(const PKMEditor& editor);
+        // Restores the PP of every move of the Pokemon in boxes firstBox through lastBox, and in
+        // the party if party is set, in one pass over storage. Only records whose PP changed are
+        // written back
+        void healPP(u8 firstBox, u8 lastBox, bool party = true);
+        // Box slots holding a Pokemon that matches filter, one bit per slot (box * 30 + slot), the
+        // filter being compiled once for the whole search. threads works as in forEachPKM
+        [[nodiscard]] std::vector<u64> findPKM(const PKFilter& filter, size_t threads = 1) const;
+        // Index (box * 30 + slot) of the first empty box slot at or after start, or -1 if there
+        // is none. Not safe to call concurrently until the occupancy index has been built
+        [[nodiscard]] int firstFreeSlot(int start = 0) const;
+        // Every empty box slot index, in ascending order
+        [[nodiscard]] std::vector<int> freeSlots(void) const;
+        // Sorts the Pokemon in boxes firstBox through lastBox by keys, earlier keys taking
+        // precedence, and packs the empty slots at the end. Records are moved as raw data. Unless
+        // stable is set, Pokemon that compare equal may change their relative order
+        void sortBoxes(
+            u8 firstBox, u8 lastBox, const std::vector<SortCriterion>& keys, bool stable = true);
+
         [[nodiscard]] virtual int maxSlot(void) const { return maxBoxes() * 30; }
 
         [[nodiscard]] virtual int maxBoxes(void) const          = 0;
         [[nodiscard]] virtual size_t maxWondercards(void) const = 0;
         [[nodiscard]] virtual Generation generation(void) const = 0;
 
+        [[nodiscard]] const VersionTables::ItemSet& itemTable(void) const
+        {
+            return VersionTables::itemTable(version());
+        }
+
+        [[nodiscard]] const VersionTables::MoveSet& moveTable(void) const
+        {
+            return VersionTables::moveTable(version());
+        }
+
+        [[nodiscard]] const VersionTables::SpeciesSet& speciesTable(void) const
+        {
+            return VersionTables::speciesTable(version());
+        }
+
+        [[nodiscard]] const VersionTables::AbilitySet& abilityTable(void) const
+        {
+            return VersionTables::abilityTable(version());
+        }
+
+        [[nodiscard]] const VersionTables::BallSet& ballTable(void) const
+        {
+            return VersionTables::ballTable(version());
+        }
+
         [[nodiscard]] const std::set<int>& availableItems(void) const
         {
             return VersionTables::availableItems(version());
@@ -256,7 +642,17 @@ namespace pksm
         [[nodiscard]] u32 getEntireLengthIncludingFooter() const { return fullLength; }
 
         [[nodiscard]] const std::shared_ptr<u8[]>& rawData() const { return data; }
+
+        friend Diff diffSaves(const Sav& before, const Sav& after);
+
+    private:
+        [[nodiscard]] std::unique_ptr<PKX> transfer(const PKX& pk, Generation generation);
     };
+
+    // Compares two versions of the same save block by block, and only looks at the Pokemon stored
+    // in blocks that differ. Both saves should be in the same state: either both being edited or
+    // both finished
+    [[nodiscard]] Sav::Diff diffSaves(const Sav& before, const Sav& after);
 }
 
 #endif
@@ -28,6 +28,7 @@
 #define SAV1_HPP
 
 #include "personal/personal.hpp"
+#include "sav/DecodedSlots.hpp"
 #include "sav/Sav.hpp"
 #include <array>
 
@@ -43,13 +44,46 @@ namespace pksm
         u16 boxSize, mainDataLength, bankBoxesSize, OFS_DEX_CAUGHT, OFS_DEX_SEEN, OFS_BAG,
             OFS_MONEY, OFS_BADGES, OFS_TID, OFS_PC_ITEMS, OFS_CURRENT_BOX_INDEX, OFS_HOURS,
             OFS_PARTY, OFS_CURRENT_BOX, OFS_MAIN_DATA_SUM, OFS_BANK2_BOX_SUMS, OFS_BANK3_BOX_SUMS;
+        // Box slots as pkm(box, slot) last decoded them, indexed by box * maxPkmInBox + slot
+        mutable DecodedSlots decodedSlots;
+        // Boxes written since the last finishEditing, one bit per box. Code that changes a box's
+        // bytes without going through the box functions has to call markBoxDirty
+        u16 dirtyBoxes = 0xFFFF;
+        // Byte sums of each box as of the last finishEditing, which the bank checksums are made of
+        std::array<u8, 12> boxByteSums{};
 
-        void fixBoxes(void);
+        void markBoxDirty(u8 box) { dirtyBoxes |= 1 << box; }
 
-        [[nodiscard]] bool getCaught(Species species) const;
+        void fixBoxes(void);
+        void updateBoxSums(void);
+
+        [[nodiscard]] std::vector<StoredSlot> storageTable(void) const override;
+        void swapPartySlots(u8 a, u8 b) override;
+        void swapBoxSlots(u8 box, u8 a, u8 b);
+        [[nodiscard]] u8 boxSlots(u8 /*box*/) const override { return maxPkmInBox; }
+        [[nodiscard]] u16 boxSlotSize(void) const override;
+        void readBoxSlot(u8 box, u8 slot, u8* out) const override;
+        void writeBoxSlot(u8 box, u8 slot, const u8* in) override;
+        void boxSlotsMoved(
+            const std::vector<StorageSlot>& slots, const std::vector<size_t>& order) override;
+
+        [[nodiscard]] bool getCaught(Species species) const override;
         void setCaught(Species species, bool caught);
-        [[nodiscard]] bool getSeen(Species species) const;
+        [[nodiscard]] bool getSeen(Species species) const override;
         void setSeen(Species species, bool seen);
+        void registerDex(const PKX& pk) override;
+
+        // finishEditing is cheap, and most of what it does has to reach the save itself anyway
+        void prepareImage(void) override { finishEditing(); }
+        void finishImage(const std::shared_ptr<u8[]>&) const override {}
+        // Which box's contents are currently held in the current box area
+        [[nodiscard]] u32 snapshotState(void) const override { return originalCurrentBox; }
+        void restoreState(u32 state) override
+        {
+            originalCurrentBox = state;
+            decodedSlots.invalidateAll();
+            dirtyBoxes = 0xFFFF;
+        }
 
     public:
         Sav1(const std::shared_ptr<u8[]>& data, u32 length);
@@ -136,7 +170,6 @@ namespace pksm
 
         [[nodiscard]] std::unique_ptr<PKX> emptyPkm(void) const override;
 
-        void dex(const PKX& pk) override;
         [[nodiscard]] int dexSeen(void) const override;
         [[nodiscard]] int dexCaught(void) const override;
 
@@ -28,6 +28,7 @@
 #define SAV2_HPP
 
 #include "personal/personal.hpp"
+#include "sav/DecodedSlots.hpp"
 #include "sav/Sav.hpp"
 #include <array>
 
@@ -45,25 +46,58 @@ namespace pksm
             OFS_BADGES, OFS_POKEDEX_CAUGHT, OFS_POKEDEX_SEEN, OFS_BOX_NAMES, OFS_TM_POUCH,
             OFS_ITEMS, OFS_KEY_ITEMS, OFS_BALLS, OFS_CHECKSUM_ONE, OFS_MONEY, OFS_CHECKSUM_TWO,
             OFS_CHECKSUM_END, OFS_TIME_PLAYED, OFS_PALETTE, OFS_TID, OFS_NAME;
+        // Box slots as pkm(box, slot) last decoded them, indexed by box * maxPkmInBox + slot
+        mutable DecodedSlots decodedSlots;
+        // Boxes written since the last finishEditing, one bit per box. Code that changes a box's
+        // bytes without going through the box functions has to call markBoxDirty
+        u16 dirtyBoxes = 0xFFFF;
+
+        void markBoxDirty(u8 box) { dirtyBoxes |= 1 << box; }
 
         void fixBoxes(void);
 
-        [[nodiscard]] bool getCaught(Species species) const;
+        [[nodiscard]] std::vector<StoredSlot> storageTable(void) const override;
+        void swapPartySlots(u8 a, u8 b) override;
+        void swapBoxSlots(u8 box, u8 a, u8 b);
+        [[nodiscard]] u8 boxSlots(u8 /*box*/) const override { return maxPkmInBox; }
+        [[nodiscard]] u16 boxSlotSize(void) const override;
+        void readBoxSlot(u8 box, u8 slot, u8* out) const override;
+        void writeBoxSlot(u8 box, u8 slot, const u8* in) override;
+        void boxSlotsMoved(
+            const std::vector<StorageSlot>& slots, const std::vector<size_t>& order) override;
+
+        [[nodiscard]] bool getCaught(Species species) const override;
         void setCaught(Species species, bool caught);
-        [[nodiscard]] bool getSeen(Species species) const;
+        [[nodiscard]] bool getSeen(Species species) const override;
         void setSeen(Species species, bool seen);
+        void registerDex(const PKX& pk) override;
 
         [[nodiscard]] static u16 calculateChecksum(u8* start, const u8* end);
 
         std::span<const int> tmItems2() const;
 
+        // finishEditing is cheap, and most of what it does has to reach the save itself anyway
+        void prepareImage(void) override { finishEditing(); }
+        void finishImage(const std::shared_ptr<u8[]>&) const override {}
+        // Which box's contents are currently held in the current box area
+        [[nodiscard]] u32 snapshotState(void) const override { return originalCurrentBox; }
+        void restoreState(u32 state) override
+        {
+            originalCurrentBox = state;
+            decodedSlots.invalidateAll();
+            dirtyBoxes = 0xFFFF;
+        }
+
     public:
         Sav2(const std::shared_ptr<u8[]>& data, u32 length,
             std::tuple<GameVersion, Language, bool> versionAndLanguage);
 
         [[nodiscard]] static std::tuple<GameVersion, Language, bool> getVersion(
             const std::shared_ptr<u8[]>& dt);
+        [[nodiscard]] static std::tuple<GameVersion, Language, bool> getVersion(
+            const ByteSource& source);
         [[nodiscard]] static bool validList(const std::shared_ptr<u8[]>& dt, size_t ofs, u8 slot);
+        [[nodiscard]] static bool validList(const ByteSource& source, size_t ofs, u8 slot);
 
         void finishEditing(void) override;
 
@@ -142,7 +176,6 @@ namespace pksm
 
         [[nodiscard]] std::unique_ptr<PKX> emptyPkm(void) const override;
 
-        void dex(const PKX& pk) override;
         [[nodiscard]] int dexSeen(void) const override;
         [[nodiscard]] int dexCaught(void) const override;
 
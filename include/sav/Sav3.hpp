@@ -27,6 +27,10 @@
 #ifndef SAV3_HPP
 #define SAV3_HPP
 
+#ifndef _PKSMCORE_CONFIGURED
+#include "PKSMCORE_CONFIG.h"
+#endif
+
 #include "personal/personal.hpp"
 #include "sav/Sav.hpp"
 #include <array>
@@ -55,8 +59,12 @@ namespace pksm
         void loadBlocks();
         [[nodiscard]] static std::array<int, BLOCK_COUNT> getBlockOrder(
             const std::shared_ptr<u8[]>& dt, int ofs);
+        [[nodiscard]] static std::array<int, BLOCK_COUNT> getBlockOrder(
+            const ByteSource& source, int ofs);
         [[nodiscard]] static int getActiveSaveIndex(const std::shared_ptr<u8[]>& dt,
             std::array<int, BLOCK_COUNT>& blockOrder1, std::array<int, BLOCK_COUNT>& blockOrder2);
+        [[nodiscard]] static int getActiveSaveIndex(const ByteSource& source,
+            std::array<int, BLOCK_COUNT>& blockOrder1, std::array<int, BLOCK_COUNT>& blockOrder2);
 
         static constexpr u16 chunkLength[BLOCK_COUNT] = {
             0xf2c, // 0 | Small Block (Trainer Info)
@@ -79,6 +87,17 @@ namespace pksm
 
         int activeSAV;
 
+        // The PC sections (5 to 13) laid end to end without their footers, so that no box record
+        // is split. Box reads come from this copy; every write goes to both it and data, through
+        // syncStorage
+        static constexpr int SIZE_STORAGE = 8 * SIZE_BLOCK_USED + 0x7d0;
+        std::unique_ptr<u8[]> storage;
+
+        [[nodiscard]] static u32 storageOffset(u8 box, u8 slot);
+        void loadStorage(void);
+        // Copies length bytes of storage from offset into the PC sections of data they came from
+        void syncStorage(u32 offset, u32 length);
+
         [[nodiscard]] u32 securityKey() const;
 
         [[nodiscard]] bool getEventFlag(int flagNumber) const;
@@ -91,23 +110,50 @@ namespace pksm
         [[nodiscard]] u32 dexPIDSpinda(void);
         void dexPIDSpinda(u32 v);
 
-        [[nodiscard]] bool getCaught(Species species) const;
+        [[nodiscard]] bool getCaught(Species species) const override;
         void setCaught(Species species, bool caught);
-        [[nodiscard]] bool getSeen(Species species) const;
+        [[nodiscard]] bool getSeen(Species species) const override;
         void setSeen(Species species, bool seen);
+        void registerDex(const PKX& pk) override;
+
+        [[nodiscard]] std::vector<StoredSlot> storageTable(void) const override;
+        void readBoxSlot(u8 box, u8 slot, u8* out) const override;
+        void writeBoxSlot(u8 box, u8 slot, const u8* in) override;
+        // Sections of the active save by section ID, then the two Hall of Fame sections. PC sections
+        // are reported from storage, which is where box records are read from
+        [[nodiscard]] std::vector<SaveBlock> saveBlocks(void) const override;
 
         Sav3(const std::shared_ptr<u8[]>& data, SmallVector<int, 3>&& seenFlagOffsets);
 
+        // data is always current, so this only picks up PC changes made through getBlock
+        void prepareImage(void) override { loadStorage(); }
+        void finishImage(const std::shared_ptr<u8[]>& image) const override
+        {
+            resign(image.get());
+        }
+        void restoreState(u32) override { loadStorage(); }
+
     public:
         static constexpr int SIZE_BLOCK = 0x1000;
         [[nodiscard]] static Game getVersion(const std::shared_ptr<u8[]>& dt);
+        // activeSave, if given, receives the index of the current save copy
+        [[nodiscard]] static Game getVersion(const ByteSource& source, int* activeSave = nullptr);
 
-        void resign(void);
+        // Writes the checksums for image, which is either data or a copy of it
+        void resign(u8* image) const;
+        // Writes the checksums for data
+        void resign(void) { resign(data.get()); }
 
-        void finishEditing(void) override { resign(); }
+        void finishEditing(void) override
+        {
+            loadStorage();
+            resign(data.get());
+        }
 
         void beginEditing(void) override {}
 
+        // Box reads only see changes made to the PC sections (5 to 13) through this once
+        // finishEditing has been called
         [[nodiscard]] u8* getBlock(size_t blockNum) { return &data[blockOfs[blockNum]]; }
 
         [[nodiscard]] u16 TID(void) const override;
@@ -175,7 +221,6 @@ namespace pksm
         void trade(PKX& pk, const Date& date = Date::today()) const override;
         [[nodiscard]] std::unique_ptr<PKX> emptyPkm() const override;
 
-        void dex(const PKX& pk) override;
         [[nodiscard]] int dexSeen(void) const override;
         [[nodiscard]] int dexCaught(void) const override;
 
@@ -52,7 +52,21 @@ namespace pksm
         [[nodiscard]] SmallVector<u8, 0x20> getDexFormValues(u32 v, u8 bitsPerForm, u8 readCt);
         void setForms(SmallVector<u8, 0x20> forms, Species species);
         [[nodiscard]] u32 setDexFormValues(SmallVector<u8, 0x20> forms, u8 bitsPerForm, u8 readCt);
+        [[nodiscard]] bool getSeen(Species species) const override;
+        [[nodiscard]] bool getCaught(Species species) const override;
+        void registerDex(const PKX& pk) override;
 
+        void finishImage(const std::shared_ptr<u8[]>& image) const override
+        {
+            resign(image.get());
+        }
+
+        // Start, end and checksum offset of the general and storage blocks, relative to gbo and sbo
+        [[nodiscard]] std::array<int, 3> generalBlock(void) const;
+        [[nodiscard]] std::array<int, 3> storageBlock(void) const;
+        [[nodiscard]] std::vector<SaveBlock> saveBlocks(void) const override;
+
+    public:
         enum class CountType
         {
             FIRST,
@@ -60,14 +74,17 @@ namespace pksm
             SAME
         };
 
+        // Which of the two save copies a pair of save counters says is newer
         [[nodiscard]] static CountType compareCounters(u32 c1, u32 c2);
 
-    public:
         Sav4(const std::shared_ptr<u8[]>& data, u32 length) : Sav(data, length) {}
 
-        void resign(void);
+        // Writes the checksums for image, which is either data or a copy of it
+        void resign(u8* image) const;
+        // Writes the checksums for data
+        void resign(void) { resign(data.get()); }
 
-        void finishEditing(void) override { resign(); }
+        void finishEditing(void) override { resign(data.get()); }
 
         void beginEditing(void) override {}
 
@@ -132,7 +149,6 @@ namespace pksm
         void trade(PKX& pk, const Date& date = Date::today()) const override;
         [[nodiscard]] std::unique_ptr<PKX> emptyPkm() const override;
 
-        void dex(const PKX& pk) override;
         [[nodiscard]] int dexSeen(void) const override;
         [[nodiscard]] int dexCaught(void) const override;
         [[nodiscard]] int currentGiftAmount(void) const override;
@@ -38,15 +38,27 @@ namespace pksm
         int TrainerCard, Trainer2, PlayTime, LastViewedBox, PokeDexLanguageFlags, EncounterCount,
             PCLayout;
 
+        void finishImage(const std::shared_ptr<u8[]>& image) const override
+        {
+            resign(image.get());
+        }
+
+        [[nodiscard]] bool getSeen(Species species) const override;
+        [[nodiscard]] bool getCaught(Species species) const override;
+        void registerDex(const PKX& pk) override;
+
     private:
         [[nodiscard]] int dexFormIndex(int species, int formct) const;
 
     public:
         Sav6(const std::shared_ptr<u8[]>& data, u32 length) : Sav(data, length) {}
 
-        virtual void resign(void) = 0;
+        // Writes the checksums for image, which is either data or a copy of it
+        virtual void resign(u8* image) const = 0;
+        // Writes the checksums for data
+        void resign(void) { resign(data.get()); }
 
-        void finishEditing(void) override { resign(); }
+        void finishEditing(void) override { resign(data.get()); }
 
         void beginEditing(void) override {}
 
@@ -102,7 +114,6 @@ namespace pksm
         void trade(PKX& pk, const Date& date = Date::today()) const override;
         [[nodiscard]] std::unique_ptr<PKX> emptyPkm() const override;
 
-        void dex(const PKX& pk) override;
         [[nodiscard]] int dexSeen(void) const override;
         [[nodiscard]] int dexCaught(void) const override;
         [[nodiscard]] int currentGiftAmount(void) const override;
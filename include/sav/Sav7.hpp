@@ -40,6 +40,14 @@ namespace pksm
 
         [[nodiscard]] virtual int dexFormIndex(int species, int formct, int start) const = 0;
         [[nodiscard]] virtual int dexFormCount(int species) const                        = 0;
+        [[nodiscard]] bool getSeen(Species species) const override;
+        [[nodiscard]] bool getCaught(Species species) const override;
+        void registerDex(const PKX& pk) override;
+
+        void finishImage(const std::shared_ptr<u8[]>& image) const override
+        {
+            resign(image.get());
+        }
 
     private:
         void setDexFlags(int index, int gender, int shiny, int baseSpecies);
@@ -49,9 +57,12 @@ namespace pksm
     public:
         Sav7(const std::shared_ptr<u8[]>& data, u32 length) : Sav(data, length) {}
 
-        virtual void resign(void) = 0;
+        // Writes the checksums for image, which is either data or a copy of it
+        virtual void resign(u8* image) const = 0;
+        // Writes the checksums for data
+        void resign(void) { resign(data.get()); }
 
-        void finishEditing(void) override { resign(); }
+        void finishEditing(void) override { resign(data.get()); }
 
         void beginEditing(void) override {}
 
@@ -108,7 +119,6 @@ namespace pksm
         void trade(PKX& pk, const Date& date = Date::today()) const override;
         [[nodiscard]] std::unique_ptr<PKX> emptyPkm() const override;
 
-        void dex(const PKX& pk) override;
         [[nodiscard]] int dexSeen(void) const override;
         [[nodiscard]] int dexCaught(void) const override;
         [[nodiscard]] int currentGiftAmount(void) const override;
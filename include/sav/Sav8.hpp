@@ -42,6 +42,13 @@ namespace pksm
 
         bool encrypted = false;
 
+        void prepareImage(void) override;
+        void finishImage(const std::shared_ptr<u8[]>& image) const override;
+        // Every block decrypted, so the data alone says what state they're in
+        void prepareSnapshot(void) override { prepareImage(); }
+        // Each block by its key
+        [[nodiscard]] std::vector<SaveBlock> saveBlocks(void) const override;
+
     public:
         Sav8(const std::shared_ptr<u8[]>& dt, size_t length);
 
@@ -49,6 +56,9 @@ namespace pksm
 
         void finishEditing(void) override;
         void beginEditing(void) override;
+        // Decrypts every block now instead of on first use, so that reads afterwards never write to
+        // the save data
+        void decryptBlocks(void);
 
         void trade(PKX& pk, const Date& date = Date::today()) const override;
         [[nodiscard]] std::unique_ptr<PKX> emptyPkm() const override;
@@ -73,10 +73,16 @@ namespace pksm
             0x25F78, 0x25F7A, 0x25F7C, 0x25F7E, 0x25F80, 0x25F82, 0x25F84, 0x25F86, 0x25F88,
             0x25F8A, 0x25F8C, 0x25F8E, 0x25F90, 0x25FA2};
 
+        [[nodiscard]] std::vector<SaveBlock> saveBlocks(void) const override
+        {
+            return blocksFrom(blockOfs, lengths);
+        }
+
     public:
         explicit SavB2W2(const std::shared_ptr<u8[]>& dt);
 
-        void resign(void) override;
+        using Sav5::resign;
+        void resign(u8* image) const override;
 
         [[nodiscard]] SmallVector<std::pair<Pouch, std::span<const int>>, 15> validItems(
             void) const override;
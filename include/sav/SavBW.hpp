@@ -72,10 +72,16 @@ namespace pksm
             0x23F78, 0x23F7A, 0x23F7C, 0x23F7E, 0x23F80, 0x23F82, 0x23F84, 0x23F86, 0x23F88,
             0x23F9A};
 
+        [[nodiscard]] std::vector<SaveBlock> saveBlocks(void) const override
+        {
+            return blocksFrom(blockOfs, lengths);
+        }
+
     public:
         explicit SavBW(const std::shared_ptr<u8[]>& dt);
 
-        void resign(void) override;
+        using Sav5::resign;
+        void resign(u8* image) const override;
 
         [[nodiscard]] SmallVector<std::pair<Pouch, std::span<const int>>, 15> validItems(
             void) const override;
@@ -52,12 +52,32 @@ namespace pksm
         int getDexFlags(int index, int baseSpecies) const;
         void setDexFlags(int index, int gender, int shiny, int baseSpecies);
         bool sanitizeFormsToIterate(Species species, int& fs, int& fe, int formIn) const;
+        [[nodiscard]] bool getSeen(Species species) const override;
+        [[nodiscard]] bool getCaught(Species species) const override;
+        void registerDex(const PKX& pk) override;
+
+        [[nodiscard]] std::vector<StoredSlot> storageTable(void) const override;
+        void boxSlotsMoved(
+            const std::vector<StorageSlot>& slots, const std::vector<size_t>& order) override;
+
+        void finishImage(const std::shared_ptr<u8[]>& image) const override
+        {
+            resign(image.get());
+        }
+
+        [[nodiscard]] std::vector<SaveBlock> saveBlocks(void) const override
+        {
+            return blocksFrom(chkofs, chklen);
+        }
 
     public:
         SavLGPE(const std::shared_ptr<u8[]>& dt, size_t length);
-        void resign(void);
+        // Writes the checksums for image, which is either data or a copy of it
+        void resign(u8* image) const;
+        // Writes the checksums for data
+        void resign(void) { resign(data.get()); }
 
-        void finishEditing(void) override { resign(); }
+        void finishEditing(void) override { resign(data.get()); }
 
         void beginEditing(void) override {}
 
@@ -136,7 +156,6 @@ namespace pksm
         void trade(PKX& pk, const Date& date = Date::today()) const override;
         [[nodiscard]] std::unique_ptr<PKX> emptyPkm() const override;
 
-        void dex(const PKX& pk) override;
         [[nodiscard]] int dexSeen(void) const override;
         [[nodiscard]] int dexCaught(void) const override;
 
@@ -38,6 +38,19 @@ namespace pksm
         static constexpr std::array<u16, 25> gigaSpecies = {6, 12, 25, 52, 68, 94, 99, 131, 133,
             143, 569, 823, 826, 834, 839, 841, 842, 844, 851, 858, 861, 869, 879, 884, 890};
 
+        // The entry for species in whichever of the three Pokedexes lists it, or nullptr
+        [[nodiscard]] const u8* dexEntry(Species species) const;
+
+    protected:
+        [[nodiscard]] std::vector<StoredSlot> storageTable(void) const override;
+        [[nodiscard]] bool getSeen(Species species) const override;
+        [[nodiscard]] bool getCaught(Species species) const override;
+        void registerDex(const PKX& pk) override;
+        [[nodiscard]] std::pair<u64, u32> dexKey(const PKX& pk) const override;
+        void swapPartySlots(u8 a, u8 b) override;
+        void readBoxSlot(u8 box, u8 slot, u8* out) const override;
+        void writeBoxSlot(u8 box, u8 slot, const u8* in) override;
+
     public:
         static constexpr size_t SIZE_G8SWSH    = 0x1716B3; // 1.0
         static constexpr size_t SIZE_G8SWSH_1  = 0x17195E; // 1.0 -> 1.1
@@ -126,7 +139,6 @@ namespace pksm
 
         void cryptBoxData(bool crypted) override;
 
-        void dex(const PKX& pk) override;
         [[nodiscard]] int dexSeen(void) const override;
         [[nodiscard]] int dexCaught(void) const override;
 
@@ -73,10 +73,16 @@ namespace pksm
         int dexFormIndex(int species, int formct, int start) const override;
         int dexFormCount(int species) const override;
 
+        [[nodiscard]] std::vector<SaveBlock> saveBlocks(void) const override
+        {
+            return blocksFrom(chkofs, chklen);
+        }
+
     public:
         explicit SavUSUM(const std::shared_ptr<u8[]>& dt);
 
-        void resign(void) override;
+        using Sav7::resign;
+        void resign(u8* image) const override;
 
         [[nodiscard]] SmallVector<std::pair<Pouch, std::span<const int>>, 15> validItems(
             void) const override;
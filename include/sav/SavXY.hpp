@@ -50,10 +50,16 @@ namespace pksm
             0x00308, 0x00618, 0x0025C, 0x00834, 0x00318, 0x007D0, 0x00C48, 0x00078, 0x00200,
             0x00C84, 0x00628, 0x34AD0, 0x0E058};
 
+        [[nodiscard]] std::vector<SaveBlock> saveBlocks(void) const override
+        {
+            return blocksFrom(chkofs, chklen);
+        }
+
     public:
         explicit SavXY(const std::shared_ptr<u8[]>& dt);
 
-        void resign(void) override;
+        using Sav6::resign;
+        void resign(u8* image) const override;
 
         [[nodiscard]] SmallVector<std::pair<Pouch, std::span<const int>>, 15> validItems(
             void) const override;
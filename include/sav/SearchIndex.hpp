@@ -0,0 +1,125 @@
+/*
+ *   This file is part of PKSM-Core
+ *   Copyright (C) 2016-2022 Bernardo Giordano, Admiral Fish, piepie62
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+ *       * Requiring preservation of specified reasonable legal notices or
+ *         author attributions in that material or in the Appropriate Legal
+ *         Notices displayed by works containing it.
+ *       * Prohibiting misrepresentation of the origin of that material,
+ *         or requiring that modified versions of such material be marked in
+ *         reasonable ways as different from the original version.
+ */
+
+#ifndef SEARCHINDEX_HPP
+#define SEARCHINDEX_HPP
+
+#ifndef _PKSMCORE_CONFIGURED
+#include "PKSMCORE_CONFIG.h"
+#endif
+
+#include "enums/Ball.hpp"
+#include "enums/Species.hpp"
+#include "sav/Sav.hpp"
+#include "utils/coretypes.h"
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace pksm
+{
+    // Inverted index over the Pokemon of any number of saves, each known by an ID chosen by the
+    // caller. Every key maps to the sorted list of slots holding a Pokemon with that key, so a
+    // query only reads the lists of the keys it names. The index can be written out and queried
+    // straight from the file through View, without loading it or reopening any save
+    class SearchIndex
+    {
+    public:
+        struct Key
+        {
+            u64 value;
+
+            [[nodiscard]] static Key species(Species species, u16 form);
+            [[nodiscard]] static Key shiny(void);
+            [[nodiscard]] static Key gigantamax(void);
+            [[nodiscard]] static Key ball(Ball ball);
+            [[nodiscard]] static Key trainer(u16 TID, u16 SID);
+            [[nodiscard]] static Key encryptionConstant(u32 ec);
+            [[nodiscard]] static Key PID(u32 pid);
+
+            [[nodiscard]] auto operator<=>(const Key&) const = default;
+        };
+
+        struct Result
+        {
+            u32 save;
+            Sav::StorageSlot where;
+        };
+
+        // Read-only index in the serialized format, queried in place. Only the key table and the
+        // posting lists a query names are read
+        class View
+        {
+        public:
+            // data must hold length bytes written by SearchIndex::serialize. valid() is false if it
+            // doesn't look like an index
+            View(std::shared_ptr<const u8[]> data, size_t length);
+#ifdef _PKSMCORE_ENABLE_MMAP
+            // Maps the file written by SearchIndex::write. Invalid if it can't be mapped
+            explicit View(const std::string& path);
+#endif
+
+            [[nodiscard]] bool valid(void) const { return data != nullptr; }
+            // As SearchIndex::query
+            [[nodiscard]] std::vector<Result> query(const std::vector<Key>& keys) const;
+
+        private:
+            friend class SearchIndex;
+
+            // First posting and posting count of key, or {0, 0} if it isn't indexed
+            [[nodiscard]] std::pair<u32, u32> find(Key key) const;
+            [[nodiscard]] u64 posting(u32 index) const;
+
+            std::shared_ptr<const u8[]> data;
+            size_t keyCount = 0;
+        };
+
+        SearchIndex() = default;
+        // Loads a written index so that it can be updated
+        explicit SearchIndex(const View& view);
+
+        // Replaces everything indexed for save with the Pokemon currently in sav. Lists that hold
+        // none of its Pokemon are left alone
+        void update(u32 save, const Sav& sav);
+        void remove(u32 save);
+
+        // Slots holding a Pokemon that has every one of keys, ordered by save, box, and slot. No
+        // keys match nothing
+        [[nodiscard]] std::vector<Result> query(const std::vector<Key>& keys) const;
+
+        [[nodiscard]] std::vector<u8> serialize(void) const;
+        [[nodiscard]] bool write(const std::string& path) const;
+
+    private:
+        // Postings are packed as save << 16 | box << 8 | slot, so that sorting them sorts by save
+        std::map<Key, std::vector<u64>> postings;
+        // Keys each save has postings under, to find them again when it is updated or removed
+        std::map<u32, std::vector<Key>> saveKeys;
+    };
+}
+
+#endif
@@ -0,0 +1,107 @@
+/*
+ *   This file is part of PKSM-Core
+ *   Copyright (C) 2016-2022 Bernardo Giordano, Admiral Fish, piepie62
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+ *       * Requiring preservation of specified reasonable legal notices or
+ *         author attributions in that material or in the Appropriate Legal
+ *         Notices displayed by works containing it.
+ *       * Prohibiting misrepresentation of the origin of that material,
+ *         or requiring that modified versions of such material be marked in
+ *         reasonable ways as different from the original version.
+ */
+
+#ifndef TRANSFERTABLE_HPP
+#define TRANSFERTABLE_HPP
+
+#include "enums/Ability.hpp"
+#include "enums/Ball.hpp"
+#include "enums/GameVersion.hpp"
+#include "enums/Generation.hpp"
+#include "enums/Move.hpp"
+#include "enums/Species.hpp"
+#include "pkx/PKX.hpp"
+#include "sav/Sav.hpp"
+#include "utils/coretypes.h"
+#include "utils/VersionTables.hpp"
+#include <array>
+
+namespace pksm
+{
+    // Everything that decides whether a Pokemon from one generation can go into one game, worked
+    // out ahead of time so that checking a Pokemon is a handful of table lookups. The single
+    // checks can also be used on their own, e.g. to grey out choices that wouldn't transfer
+    class TransferTable
+    {
+    public:
+        // Built the first time each pair is asked for and kept from then on
+        [[nodiscard]] static const TransferTable& get(Generation source, GameVersion target);
+
+        [[nodiscard]] bool moveAllowed(Move move) const { return moves.contains(move); }
+
+        [[nodiscard]] bool speciesAllowed(Species species) const
+        {
+            return this->species.contains(species);
+        }
+
+        // Allows the forms a species only gets once it evolves, as Scatterbug does
+        [[nodiscard]] bool formAllowed(Species species, u16 form) const
+        {
+            return size_t(species) < forms.size() && form < forms[size_t(species)];
+        }
+
+        // Always true if either side is Gen I or II, neither of which has abilities
+        [[nodiscard]] bool abilityAllowed(Ability ability) const
+        {
+            return !checkAbility || abilities.contains(ability);
+        }
+
+        // Always true for a Gen I or II target
+        [[nodiscard]] bool ballAllowed(Ball ball) const
+        {
+            return !checkBall || balls.contains(ball);
+        }
+
+        // The ID that held items are checked by: the source format's own ID if the target
+        // numbers items the same way (Gen I/II into Gen I/II, Gen III into Gen III), otherwise
+        // the national ID
+        [[nodiscard]] int itemKey(const PKX& pk) const;
+
+        [[nodiscard]] bool itemAllowed(int key) const { return items.contains(key); }
+
+        // The same checks in the same order as Sav::invalidTransferReason. pk must be from the
+        // source generation
+        [[nodiscard]] Sav::BadTransferReason check(const PKX& pk) const;
+
+    private:
+        TransferTable(Generation source, GameVersion target);
+
+        Generation source;
+        const VersionTables::MoveSet& moves;
+        const VersionTables::SpeciesSet& species;
+        const VersionTables::AbilitySet& abilities;
+        const VersionTables::BallSet& balls;
+        // Number of forms allowed for each species
+        std::array<u8, 1024> forms{};
+        VersionTables::ItemSet items;
+        bool checkAbility;
+        bool checkBall;
+        // Whether items are keyed by the source format's own ID
+        bool rawItems;
+    };
+}
+
+#endif
@@ -33,10 +33,151 @@
 #include "enums/Generation.hpp"
 #include "enums/Move.hpp"
 #include "enums/Species.hpp"
+#include <array>
+#include <bit>
+#include <initializer_list>
+#include <iterator>
 #include <set>
 
 namespace pksm::VersionTables
 {
+    // Set of IDs below N stored as one bit per ID, so it can be built at compile time and
+    // membership is a single bit test
+    template <typename T, size_t N>
+    class IdSet
+    {
+    private:
+        static constexpr size_t WORDS = (N + 63) / 64;
+
+        std::array<u64, WORDS> words{};
+
+    public:
+        class iterator
+        {
+        private:
+            const IdSet* set = nullptr;
+            size_t index     = N;
+
+            constexpr void skip()
+            {
+                while (index < N)
+                {
+                    u64 rest = set->words[index / 64] >> (index % 64);
+                    if (rest)
+                    {
+                        index += std::countr_zero(rest);
+                        return;
+                    }
+                    index = (index / 64 + 1) * 64;
+                }
+                index = N;
+            }
+
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type        = T;
+            using difference_type   = std::ptrdiff_t;
+            using pointer           = const T*;
+            using reference         = T;
+
+            constexpr iterator() = default;
+
+            constexpr iterator(const IdSet* set, size_t index) : set(set), index(index) { skip(); }
+
+            constexpr T operator*() const { return T(index); }
+
+            constexpr iterator& operator++()
+            {
+                index++;
+                skip();
+                return *this;
+            }
+
+            constexpr iterator operator++(int)
+            {
+                iterator ret = *this;
+                ++*this;
+                return ret;
+            }
+
+            constexpr bool operator==(const iterator& other) const { return index == other.index; }
+        };
+
+        constexpr IdSet() = default;
+
+        constexpr IdSet(std::initializer_list<T> ids)
+        {
+            for (const T& id : ids)
+            {
+                insert(id);
+            }
+        }
+
+        // Every ID from first to last, inclusive
+        [[nodiscard]] static constexpr IdSet range(T first, T last)
+        {
+            IdSet ret;
+            for (size_t i = size_t(first); i <= size_t(last); i++)
+            {
+                ret.insert(T(i));
+            }
+            return ret;
+        }
+
+        constexpr void insert(T id)
+        {
+            if (size_t(id) < N)
+            {
+                words[size_t(id) / 64] |= u64(1) << (size_t(id) % 64);
+            }
+        }
+
+        constexpr void erase(T id)
+        {
+            if (size_t(id) < N)
+            {
+                words[size_t(id) / 64] &= ~(u64(1) << (size_t(id) % 64));
+            }
+        }
+
+        [[nodiscard]] constexpr bool contains(T id) const
+        {
+            return size_t(id) < N && (words[size_t(id) / 64] >> (size_t(id) % 64)) & 1;
+        }
+
+        [[nodiscard]] constexpr size_t count(T id) const { return contains(id) ? 1 : 0; }
+
+        [[nodiscard]] constexpr size_t size() const
+        {
+            size_t ret = 0;
+            for (u64 word : words)
+            {
+                ret += std::popcount(word);
+            }
+            return ret;
+        }
+
+        [[nodiscard]] constexpr bool empty() const { return begin() == end(); }
+
+        [[nodiscard]] constexpr iterator begin() const { return iterator(this, 0); }
+
+        [[nodiscard]] constexpr iterator end() const { return iterator(this, N); }
+    };
+
+    using ItemSet    = IdSet<int, 2048>;
+    using MoveSet    = IdSet<Move, 1024>;
+    using SpeciesSet = IdSet<Species, 1024>;
+    using AbilitySet = IdSet<Ability, 512>;
+    using BallSet    = IdSet<Ball, 32>;
+
+    // Tables are built at compile time; prefer these to the std::set versions below
+    [[nodiscard]] const ItemSet& itemTable(GameVersion version);
+    [[nodiscard]] const MoveSet& moveTable(GameVersion version);
+    [[nodiscard]] const SpeciesSet& speciesTable(GameVersion version);
+    [[nodiscard]] const AbilitySet& abilityTable(GameVersion version);
+    [[nodiscard]] const BallSet& ballTable(GameVersion version);
+
+    // Copies of the tables above, built the first time they are asked for
     [[nodiscard]] const std::set<int>& availableItems(GameVersion version);
     [[nodiscard]] const std::set<Move>& availableMoves(GameVersion version);
     [[nodiscard]] const std::set<Species>& availableSpecies(GameVersion version);
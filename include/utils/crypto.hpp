@@ -34,6 +34,14 @@
 #include <string>
 #include <vector>
 
+#ifndef _PKSMCORE_CONFIGURED
+#include "PKSMCORE_CONFIG.h"
+#endif
+
+#ifndef _PKSMCORE_DISABLE_THREAD_SAFETY
+#include <atomic>
+#endif
+
 namespace pksm::crypto
 {
     [[nodiscard]] u16 ccitt16(std::span<const u8> data);
@@ -131,9 +139,16 @@ namespace pksm::crypto
                 Double = 17,
             };
             u32 key() const;
-            // Nop if in proper state
+            // Where the block starts in the save, and how many bytes it takes up from there
+            size_t offset() const { return myOffset; }
+            size_t size() const { return encryptedDataSize(); }
+            // Nop if in proper state. decrypt may be called from several threads at once: one of
+            // them does the work and the others wait for it. encrypt must not race with anything
             void encrypt();
             void decrypt();
+            // Encrypts this block's bytes in image, a copy of the buffer it lives in, in which the
+            // block is decrypted. The block itself is left alone
+            void encryptCopy(u8* image) const;
 
             u8* decryptedData()
             {
@@ -158,9 +173,22 @@ namespace pksm::crypto
             size_t dataLength;
             SCBlockType type;
             SCBlockType subtype;
-            bool currentlyEncrypted = false;
 
-            size_t encryptedDataSize();
+            enum class CryptState : u8
+            {
+                DECRYPTED,
+                DECRYPTING,
+                ENCRYPTED
+            };
+#ifdef _PKSMCORE_DISABLE_THREAD_SAFETY
+            CryptState state = CryptState::DECRYPTED;
+#else
+            std::atomic<CryptState> state = CryptState::DECRYPTED;
+#endif
+
+            void applyXor(u8* buffer) const;
+
+            size_t encryptedDataSize() const;
             static size_t arrayEntrySize(SCBlockType type);
             static size_t headerSize(SCBlockType type);
         };
@@ -0,0 +1,126 @@
+/*
+ *   This file is part of PKSM-Core
+ *   Copyright (C) 2016-2022 Bernardo Giordano, Admiral Fish, piepie62
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+ *       * Requiring preservation of specified reasonable legal notices or
+ *         author attributions in that material or in the Appropriate Legal
+ *         Notices displayed by works containing it.
+ *       * Prohibiting misrepresentation of the origin of that material,
+ *         or requiring that modified versions of such material be marked in
+ *         reasonable ways as different from the original version.
+ */
+
+#ifndef EXECUTOR_HPP
+#define EXECUTOR_HPP
+
+#ifndef _PKSMCORE_CONFIGURED
+#include "PKSMCORE_CONFIG.h"
+#endif
+
+#include "utils/coretypes.h"
+#include <functional>
+#include <memory>
+
+#ifndef _PKSMCORE_DISABLE_THREAD_SAFETY
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#endif
+
+namespace pksm
+{
+    // Where bulk operations run their independent pieces of work
+    class Executor
+    {
+    public:
+        virtual ~Executor() = default;
+        // Calls task(i) for every i in [0, count) and returns once all of them have finished. The
+        // calls may happen in any order and on any thread, so they must not depend on each other
+        virtual void parallelFor(size_t count, const std::function<void(size_t)>& task) = 0;
+        // Runs task once at some later point, possibly on another thread, without waiting for it
+        virtual void post(std::function<void()> task) = 0;
+        // How many tasks may run at once
+        [[nodiscard]] virtual size_t concurrency(void) const = 0;
+    };
+
+    // Runs everything on the calling thread, in order
+    class InlineExecutor : public Executor
+    {
+    public:
+        void parallelFor(size_t count, const std::function<void(size_t)>& task) override;
+        // Runs task immediately
+        void post(std::function<void()> task) override { task(); }
+        [[nodiscard]] size_t concurrency(void) const override { return 1; }
+    };
+
+#ifndef _PKSMCORE_DISABLE_THREAD_SAFETY
+    // Each worker has its own queue and takes work from the others' when it runs dry. The thread
+    // calling parallelFor helps out until its tasks are done, so nested calls can't deadlock
+    class ThreadPool : public Executor
+    {
+    public:
+        // One worker for each core besides the caller's
+        ThreadPool(void);
+        // threads is the number of workers besides the caller
+        explicit ThreadPool(size_t threads);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&)            = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        void parallelFor(size_t count, const std::function<void(size_t)>& task) override;
+        // Posted tasks still waiting when the pool is destroyed are run before it finishes
+        void post(std::function<void()> task) override;
+        [[nodiscard]] size_t concurrency(void) const override { return workers.size() + 1; }
+
+    private:
+        struct Queue
+        {
+            std::mutex lock;
+            std::deque<std::function<void()>> tasks;
+        };
+
+        std::vector<std::unique_ptr<Queue>> queues;
+        std::vector<std::thread> workers;
+        std::mutex sleepLock;
+        std::condition_variable wake;
+        // Tasks waiting in any queue. A worker may take a task before it has been counted, so this
+        // can briefly dip below zero
+        std::atomic<ptrdiff_t> queued = 0;
+        std::atomic<size_t> nextQueue = 0;
+        bool stopping                 = false;
+
+        void work(size_t home);
+        // Runs one queued task, preferring the back of queues[home] and otherwise stealing from the
+        // front of another queue. Returns false if every queue was empty
+        bool runOne(size_t home);
+    };
+#endif
+
+    // The executor used by the library's bulk operations. Unless replaced, this is a ThreadPool
+    // with a worker per extra core, or an InlineExecutor when thread safety is disabled
+    [[nodiscard]] std::shared_ptr<Executor> executor(void);
+    // Replaces the executor used by bulk operations. nullptr restores the default. Operations
+    // already running keep the executor they started with
+    void executor(std::shared_ptr<Executor> executor);
+}
+
+#endif
@@ -28,6 +28,7 @@
 #define FLAG_UTIL_HPP
 
 #include "utils/coretypes.h"
+#include <initializer_list>
 
 namespace pksm::FlagUtil
 {
@@ -36,6 +37,10 @@ namespace pksm::FlagUtil
 
     // Sets a bitflag in a byte array
     void setFlag(u8* data, int offset, int bitIndex, bool v);
+
+    // Counts the flags among the first bitCount that are set in any of the regions, a word at a
+    // time. Bits are numbered the way getFlag numbers them
+    [[nodiscard]] int countFlags(std::initializer_list<const u8*> regions, int bitCount);
 }
 
 #endif
@@ -27,11 +27,30 @@
 #ifndef IO_HPP
 #define IO_HPP
 
+#ifndef _PKSMCORE_CONFIGURED
+#include "PKSMCORE_CONFIG.h"
+#endif
+
+#include "utils/coretypes.h"
+#include <memory>
 #include <string>
 
 namespace io
 {
     [[nodiscard]] bool exists(const std::string& name);
+
+#ifdef _PKSMCORE_ENABLE_MMAP
+    // Private copy-on-write mapping of a whole file, or nullptr on failure. Pages are only read
+    // from disk when touched, and writes never reach the file
+    [[nodiscard]] std::shared_ptr<u8[]> mapFile(const std::string& name, size_t& length);
+    // Writes the pages of data that differ from the contents of name, creating it if needed. If
+    // data came from mapFile of this same file, pages that were never written to are skipped
+    // without being compared
+    [[nodiscard]] bool writeChanged(
+        const std::string& name, const u8* data, size_t length, bool mapped);
+    // Whether both names lead to the same file, going by device and inode rather than by path
+    [[nodiscard]] bool sameFile(const std::string& a, const std::string& b);
+#endif
 }
 
 #endif
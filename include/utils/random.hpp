@@ -28,6 +28,7 @@
 #define RANDOM_HPP
 
 #include "utils/coretypes.h"
+#include <memory>
 #include <random>
 
 namespace pksm
@@ -36,6 +37,21 @@ namespace pksm
     void seedRand(u32 seed);
     [[nodiscard]] u32 randomNumber(u32 minInclusive, u32 maxInclusive);
 
+    // Saves the calling thread's generator and puts it back when destroyed, so that reseeding in
+    // between doesn't change what that thread draws afterwards
+    class RandomStateGuard
+    {
+    public:
+        RandomStateGuard();
+        ~RandomStateGuard();
+        RandomStateGuard(const RandomStateGuard&)            = delete;
+        RandomStateGuard& operator=(const RandomStateGuard&) = delete;
+
+    private:
+        struct State;
+        std::unique_ptr<State> saved;
+    };
+
     struct UniformRandomBitGenerator
     {
         using result_type = u32;
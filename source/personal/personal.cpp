@@ -35,15 +35,88 @@
 #include "personal7b.h"
 #include "personal8.h"
 #include "utils/endian.hpp"
+#include "utils/io.hpp"
 
+#include <algorithm>
 #include <memory>
 
-#define READ_PERSONAL(name, size) readPersonal(_PKSMCORE_PERSONAL_FOLDER name, size)
+#ifndef _PKSMCORE_CONFIGURED
+#include "PKSMCORE_CONFIG.h"
+#endif
+
+#ifdef _PKSMCORE_EMBED_PERSONALS
+#define LOAD_PERSONAL(name) return name##_data
+#else
+#define LOAD_PERSONAL(name)                                                                        \
+    static auto personal = readPersonal(_PKSMCORE_PERSONAL_FOLDER #name, name##_size);            \
+    return personal.get()
+#endif
 
 namespace
 {
-    std::unique_ptr<u8[]> readPersonal(std::string_view path, size_t nominalSize)
+#ifdef _PKSMCORE_EMBED_PERSONALS
+    // Generated from personals/ by `make personals`
+    constexpr u8 personal1_data[] = {
+#include "personal1.inc"
+    };
+    static_assert(sizeof(personal1_data) == personal1_size);
+
+    constexpr u8 personal2_data[] = {
+#include "personal2.inc"
+    };
+    static_assert(sizeof(personal2_data) == personal2_size);
+
+    constexpr u8 personal3_data[] = {
+#include "personal3.inc"
+    };
+    static_assert(sizeof(personal3_data) == personal3_size);
+
+    constexpr u8 personal4_data[] = {
+#include "personal4.inc"
+    };
+    static_assert(sizeof(personal4_data) == personal4_size);
+
+    constexpr u8 personal5_data[] = {
+#include "personal5.inc"
+    };
+    static_assert(sizeof(personal5_data) == personal5_size);
+
+    constexpr u8 personal6_data[] = {
+#include "personal6.inc"
+    };
+    static_assert(sizeof(personal6_data) == personal6_size);
+
+    constexpr u8 personal7_data[] = {
+#include "personal7.inc"
+    };
+    static_assert(sizeof(personal7_data) == personal7_size);
+
+    constexpr u8 personal7b_data[] = {
+#include "personal7b.inc"
+    };
+    static_assert(sizeof(personal7b_data) == personal7b_size);
+
+    constexpr u8 personal8_data[] = {
+#include "personal8.inc"
+    };
+    static_assert(sizeof(personal8_data) == personal8_size);
+#else
+    std::shared_ptr<u8[]> readPersonal(std::string_view path, size_t nominalSize)
     {
+#ifdef _PKSMCORE_ENABLE_MMAP
+        // Only the pages that get looked at are read
+        size_t size               = 0;
+        std::shared_ptr<u8[]> ret = io::mapFile(std::string(path), size);
+        if (!ret)
+        {
+            throw std::runtime_error("Could not open personal file `" + std::string(path) + "`");
+        }
+        if (nominalSize != size)
+        {
+            throw std::runtime_error("Personal size does not match");
+        }
+        return ret;
+#else
         FILE* personal = fopen(path.data(), "rb");
         if (personal)
         {
@@ -69,60 +142,154 @@ namespace
         {
             throw std::runtime_error("Could not open personal file `" + std::string(path) + "`");
         }
+#endif
     }
+#endif
 
     const u8* personal7b()
     {
-        static auto personal = READ_PERSONAL("personal7b", personal7b_size);
-        return personal.get();
+        LOAD_PERSONAL(personal7b);
     }
 
     const u8* personal7()
     {
-        static auto personal = READ_PERSONAL("personal7", personal7_size);
-        return personal.get();
+        LOAD_PERSONAL(personal7);
     }
 
     const u8* personal6()
     {
-        static auto personal = READ_PERSONAL("personal6", personal6_size);
-        return personal.get();
+        LOAD_PERSONAL(personal6);
     }
 
     const u8* personal5()
     {
-        static auto personal = READ_PERSONAL("personal5", personal5_size);
-        return personal.get();
+        LOAD_PERSONAL(personal5);
     }
 
     const u8* personal4()
     {
-        static auto personal = READ_PERSONAL("personal4", personal4_size);
-        return personal.get();
+        LOAD_PERSONAL(personal4);
     }
 
     const u8* personal8()
     {
-        static auto personal = READ_PERSONAL("personal8", personal8_size);
-        return personal.get();
+        LOAD_PERSONAL(personal8);
     }
 
     const u8* personal3()
     {
-        static auto personal = READ_PERSONAL("personal3", personal3_size);
-        return personal.get();
+        LOAD_PERSONAL(personal3);
     }
 
     const u8* personal2()
     {
-        static auto personal = READ_PERSONAL("personal2", personal2_size);
-        return personal.get();
+        LOAD_PERSONAL(personal2);
     }
 
     const u8* personal1()
     {
-        static auto personal = READ_PERSONAL("personal1", personal1_size);
-        return personal.get();
+        LOAD_PERSONAL(personal1);
+    }
+
+    // Gens 5 through 7 and LGPE share the layout of the first 0x11 bytes
+    template <int EntrySize>
+    pksm::PersonalEntry modernEntry(const u8* data, u16 species)
+    {
+        const u8* row = data + species * EntrySize;
+        return pksm::PersonalEntry{
+            .baseHP         = row[0x0],
+            .baseAtk        = row[0x1],
+            .baseDef        = row[0x2],
+            .baseSpe        = row[0x3],
+            .baseSpa        = row[0x4],
+            .baseSpd        = row[0x5],
+            .type1          = pksm::Type{row[0x6]},
+            .type2          = pksm::Type{row[0x7]},
+            .gender         = row[0x8],
+            .baseFriendship = row[0x9],
+            .expType        = row[0xA],
+            .formCount      = row[0x10],
+            .formStatIndex  = LittleEndian::convertTo<u16>(row + 0xE),
+            .abilities      = {
+                pksm::Ability{row[0xB]}, pksm::Ability{row[0xC]}, pksm::Ability{row[0xD]}}
+        };
+    }
+
+    pksm::PersonalEntry swshEntry(const u8* data, u16 species)
+    {
+        const u8* row = data + species * personal8_entrysize;
+        return pksm::PersonalEntry{
+            .baseHP         = row[0x0],
+            .baseAtk        = row[0x1],
+            .baseDef        = row[0x2],
+            .baseSpe        = row[0x3],
+            .baseSpa        = row[0x4],
+            .baseSpd        = row[0x5],
+            .type1          = pksm::Type{row[0x6]},
+            .type2          = pksm::Type{row[0x7]},
+            .gender         = row[0x8],
+            .baseFriendship = row[0x9],
+            .expType        = row[0xA],
+            .formCount      = row[0xB],
+            .formStatIndex  = LittleEndian::convertTo<u16>(row + 0x12),
+            .abilities      = {pksm::Ability{LittleEndian::convertTo<u16>(row + 0xC)},
+                pksm::Ability{LittleEndian::convertTo<u16>(row + 0xE)},
+                pksm::Ability{LittleEndian::convertTo<u16>(row + 0x10)}}
+        };
+    }
+
+    // Gens 3 and 4 still have the ??? type at index 9
+    pksm::Type legacyType(u8 typeVal)
+    {
+        return pksm::Type{typeVal > 8 ? u8(typeVal - 1) : typeVal};
+    }
+
+    // Gens 3 and 4 share the layout of the first 0xD bytes; only Gen 4 has a form stat index
+    pksm::PersonalEntry legacyEntry(const u8* row, u8 formCount, u16 formStatIndex)
+    {
+        return pksm::PersonalEntry{
+            .baseHP         = row[0x0],
+            .baseAtk        = row[0x1],
+            .baseDef        = row[0x2],
+            .baseSpe        = row[0x3],
+            .baseSpa        = row[0x4],
+            .baseSpd        = row[0x5],
+            .type1          = legacyType(row[0x6]),
+            .type2          = legacyType(row[0x7]),
+            .gender         = row[0x8],
+            .baseFriendship = row[0x9],
+            .expType        = row[0xA],
+            .formCount      = formCount,
+            .formStatIndex  = formStatIndex,
+            .abilities      = {
+                pksm::Ability{row[0xB]}, pksm::Ability{row[0xC]}, pksm::Ability::None}
+        };
+    }
+
+    pksm::PersonalEntry gen4Entry(const u8* data, u16 species)
+    {
+        const u8* row = data + species * personal4_entrysize;
+        // Same normalization as PersonalDPPtHGSS::formCount
+        u8 formCount = species == 201 ? 28 : std::max(row[0xF], u8(1));
+        return legacyEntry(row, formCount, LittleEndian::convertTo<u16>(row + 0xD));
+    }
+
+    pksm::PersonalEntry gen3Entry(const u8* data, u16 species)
+    {
+        return legacyEntry(data + species * personal3_entrysize,
+            pksm::PersonalRSFRLGE::formCount(species), 0);
+    }
+
+    template <typename Decode>
+    size_t decodeEntries(const u8* data, std::span<const u16> formSpecies,
+        std::span<pksm::PersonalEntry> out, Decode decode)
+    {
+        const size_t count = std::min(formSpecies.size(), out.size());
+        for (size_t i = 0; i < count; i++)
+        {
+            out[i] = decode(data, formSpecies[i]);
+        }
+        return count;
     }
 }
 
@@ -200,6 +367,16 @@ namespace pksm
         {
             return personal7b()[species * personal7b_entrysize + 0x10];
         }
+
+        PersonalEntry entry(u16 species)
+        {
+            return modernEntry<personal7b_entrysize>(personal7b(), species);
+        }
+
+        size_t entries(std::span<const u16> formSpecies, std::span<PersonalEntry> out)
+        {
+            return decodeEntries(personal7b(), formSpecies, out, modernEntry<personal7b_entrysize>);
+        }
     }
 
     namespace PersonalSMUSUM
@@ -273,6 +450,16 @@ namespace pksm
         {
             return personal7()[species * personal7_entrysize + 0x10];
         }
+
+        PersonalEntry entry(u16 species)
+        {
+            return modernEntry<personal7_entrysize>(personal7(), species);
+        }
+
+        size_t entries(std::span<const u16> formSpecies, std::span<PersonalEntry> out)
+        {
+            return decodeEntries(personal7(), formSpecies, out, modernEntry<personal7_entrysize>);
+        }
     }
 
     namespace PersonalXYORAS
@@ -346,6 +533,16 @@ namespace pksm
         {
             return personal6()[species * personal6_entrysize + 0x10];
         }
+
+        PersonalEntry entry(u16 species)
+        {
+            return modernEntry<personal6_entrysize>(personal6(), species);
+        }
+
+        size_t entries(std::span<const u16> formSpecies, std::span<PersonalEntry> out)
+        {
+            return decodeEntries(personal6(), formSpecies, out, modernEntry<personal6_entrysize>);
+        }
     }
 
     namespace PersonalBWB2W2
@@ -419,6 +616,16 @@ namespace pksm
         {
             return personal5()[species * personal5_entrysize + 0x10];
         }
+
+        PersonalEntry entry(u16 species)
+        {
+            return modernEntry<personal5_entrysize>(personal5(), species);
+        }
+
+        size_t entries(std::span<const u16> formSpecies, std::span<PersonalEntry> out)
+        {
+            return decodeEntries(personal5(), formSpecies, out, modernEntry<personal5_entrysize>);
+        }
     }
 
     namespace PersonalDPPtHGSS
@@ -521,6 +728,16 @@ namespace pksm
                 return count;
             }
         }
+
+        PersonalEntry entry(u16 species)
+        {
+            return gen4Entry(personal4(), species);
+        }
+
+        size_t entries(std::span<const u16> formSpecies, std::span<PersonalEntry> out)
+        {
+            return decodeEntries(personal4(), formSpecies, out, gen4Entry);
+        }
     }
 
     namespace PersonalSWSH
@@ -596,6 +813,16 @@ namespace pksm
             return LittleEndian::convertTo<u16>(personal8() + species * personal8_entrysize + 0x12);
         }
 
+        PersonalEntry entry(u16 species)
+        {
+            return swshEntry(personal8(), species);
+        }
+
+        size_t entries(std::span<const u16> formSpecies, std::span<PersonalEntry> out)
+        {
+            return decodeEntries(personal8(), formSpecies, out, swshEntry);
+        }
+
         u16 pokedexIndex(u16 species)
         {
             return LittleEndian::convertTo<u16>(personal8() + species * personal8_entrysize + 0x14);
@@ -608,7 +835,7 @@ namespace pksm
 
         u16 crowndexIndex(u16 species)
         {
-            return LittleEndian::convertTo<u16>(personal8() + species + personal8_entrysize + 0x18);
+            return LittleEndian::convertTo<u16>(personal8() + species * personal8_entrysize + 0x18);
         }
 
         bool canLearnTR(u16 species, u8 trID)
@@ -711,6 +938,16 @@ namespace pksm
                     return 4;
             }
         }
+
+        PersonalEntry entry(u16 species)
+        {
+            return gen3Entry(personal3(), species);
+        }
+
+        size_t entries(std::span<const u16> formSpecies, std::span<PersonalEntry> out)
+        {
+            return decodeEntries(personal3(), formSpecies, out, gen3Entry);
+        }
     }
 
     namespace PersonalGSC
@@ -743,13 +743,7 @@ namespace pksm
 
     u8 PB7::level(void) const
     {
-        u8 i      = 1;
-        u8 xpType = expType();
-        while (experience() >= expTable(i, xpType) && ++i < 100)
-        {
-            ;
-        }
-        return i;
+        return levelFromExp(expType());
     }
 
     void PB7::level(u8 v)
@@ -792,6 +786,12 @@ namespace pksm
     }
 
     u16 PB7::statImpl(Stat stat) const
+    {
+        const PersonalEntry personal = PersonalLGPE::entry(formSpecies());
+        return statImpl(stat, personal, levelFromExp(personal.expType));
+    }
+
+    u16 PB7::statImpl(Stat stat, const PersonalEntry& personal, u8 lvl) const
     {
         u16 calc;
         u8 mult = 10, basestat = 0;
@@ -799,22 +799,22 @@ namespace pksm
         switch (stat)
         {
             case Stat::HP:
-                basestat = baseHP();
+                basestat = personal.baseHP;
                 break;
             case Stat::ATK:
-                basestat = baseAtk();
+                basestat = personal.baseAtk;
                 break;
             case Stat::DEF:
-                basestat = baseDef();
+                basestat = personal.baseDef;
                 break;
             case Stat::SPD:
-                basestat = baseSpe();
+                basestat = personal.baseSpe;
                 break;
             case Stat::SPATK:
-                basestat = baseSpa();
+                basestat = personal.baseSpa;
                 break;
             case Stat::SPDEF:
-                basestat = baseSpd();
+                basestat = personal.baseSpd;
                 break;
         }
 
@@ -824,7 +824,7 @@ namespace pksm
                 10 + ((2 * basestat) +
                          ((((data[0xDE] >> hyperTrainLookup[u8(stat)]) & 1) == 1) ? 31 : iv(stat)) +
                          ev(stat) / 4 + 100) *
-                         level() / 100;
+                         lvl / 100;
         }
         else
         {
@@ -832,7 +832,7 @@ namespace pksm
                 5 + (2 * basestat +
                         ((((data[0xDE] >> hyperTrainLookup[u8(stat)]) & 1) == 1) ? 31 : iv(stat)) +
                         ev(stat) / 4) *
-                        level() / 100;
+                        lvl / 100;
         }
         if (u8(nature()) / 5 + 1 == u8(stat))
         {
@@ -915,19 +915,22 @@ namespace pksm
 
     u16 PB7::CP() const
     {
-        int base  = stat(Stat::HP) + 10 + level(); // HP
+        const PersonalEntry personal = PersonalLGPE::entry(formSpecies());
+        const u8 lvl                 = levelFromExp(personal.expType);
+
+        int base  = stat(Stat::HP, personal, lvl) + 10 + lvl; // HP
         int mult  = ((currentFriendship() / 255.0f / 10.0f) + 1.0f) * 100.0f;
         int awake = awakened(Stat::HP);
 
         for (int i = 1; i < 6; i++)
         {
-            base  += stat(Stat(i)) * mult / 100;
+            base  += stat(Stat(i), personal, lvl) * mult / 100;
             awake += awakened(Stat(i));
         }
 
-        base = u16((float)(base * 6 * level()) / 100.0f);
+        base = u16((float)(base * 6 * lvl) / 100.0f);
 
-        double modifier = level() / 100.0 + 2.0;
+        double modifier = lvl / 100.0 + 2.0;
         awake           = u16(modifier) * awake;
         return std::min(10000, base + awake);
     }
@@ -956,12 +959,14 @@ namespace pksm
     {
         static constexpr Stat stats[] = {
             Stat::HP, Stat::ATK, Stat::DEF, Stat::SPD, Stat::SPATK, Stat::SPDEF};
+        const PersonalEntry personal = PersonalLGPE::entry(formSpecies());
+        const u8 lvl                 = levelFromExp(personal.expType);
         for (size_t i = 0; i < 6; i++)
         {
-            partyStat(stats[i], stat(stats[i]));
+            partyStat(stats[i], stat(stats[i], personal, lvl));
         }
-        partyLevel(level());
-        partyCurrHP(stat(Stat::HP));
+        partyLevel(lvl);
+        partyCurrHP(stat(Stat::HP, personal, lvl));
         partyCP(CP());
     }
 
@@ -947,13 +947,7 @@ namespace pksm
 
     u8 PK3::level() const
     {
-        u8 i      = 1;
-        u8 xpType = expType();
-        while (experience() >= expTable(i, xpType) && ++i < 100)
-        {
-            ;
-        }
-        return i;
+        return levelFromExp(expType());
     }
 
     void PK3::level(u8 v)
@@ -1112,6 +1106,12 @@ namespace pksm
     }
 
     u16 PK3::statImpl(Stat stat) const
+    {
+        const PersonalEntry personal = PersonalRSFRLGE::entry(formSpecies());
+        return statImpl(stat, personal, levelFromExp(personal.expType));
+    }
+
+    u16 PK3::statImpl(Stat stat, const PersonalEntry& personal, u8 lvl) const
     {
         u16 calc;
         u8 mult = 10, basestat = 0;
@@ -1119,32 +1119,32 @@ namespace pksm
         switch (stat)
         {
             case Stat::HP:
-                basestat = baseHP();
+                basestat = personal.baseHP;
                 break;
             case Stat::ATK:
-                basestat = baseAtk();
+                basestat = personal.baseAtk;
                 break;
             case Stat::DEF:
-                basestat = baseDef();
+                basestat = personal.baseDef;
                 break;
             case Stat::SPD:
-                basestat = baseSpe();
+                basestat = personal.baseSpe;
                 break;
             case Stat::SPATK:
-                basestat = baseSpa();
+                basestat = personal.baseSpa;
                 break;
             case Stat::SPDEF:
-                basestat = baseSpd();
+                basestat = personal.baseSpd;
                 break;
         }
 
         if (stat == Stat::HP)
         {
-            calc = 10 + (2 * basestat + iv(stat) + ev(stat) / 4 + 100) * level() / 100;
+            calc = 10 + (2 * basestat + iv(stat) + ev(stat) / 4 + 100) * lvl / 100;
         }
         else
         {
-            calc = 5 + (2 * basestat + iv(stat) + ev(stat) / 4) * level() / 100;
+            calc = 5 + (2 * basestat + iv(stat) + ev(stat) / 4) * lvl / 100;
         }
 
         if (u8(nature()) / 5 + 1 == u8(stat))
@@ -1162,11 +1162,13 @@ namespace pksm
     {
         static constexpr Stat stats[] = {
             Stat::HP, Stat::ATK, Stat::DEF, Stat::SPD, Stat::SPATK, Stat::SPDEF};
+        const PersonalEntry personal = PersonalRSFRLGE::entry(formSpecies());
+        const u8 lvl                 = levelFromExp(personal.expType);
         for (size_t i = 0; i < 6; i++)
         {
-            partyStat(stats[i], stat(stats[i]));
+            partyStat(stats[i], stat(stats[i], personal, lvl));
         }
-        partyLevel(level());
-        partyCurrHP(stat(Stat::HP));
+        partyLevel(lvl);
+        partyCurrHP(stat(Stat::HP, personal, lvl));
     }
 }
@@ -0,0 +1,214 @@
+/*
+ *   This file is part of PKSM-Core
+ *   Copyright (C) 2016-2022 Bernardo Giordano, Admiral Fish, piepie62
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+ *       * Requiring preservation of specified reasonable legal notices or
+ *         author attributions in that material or in the Appropriate Legal
+ *         Notices displayed by works containing it.
+ *       * Prohibiting misrepresentation of the origin of that material,
+ *         or requiring that modified versions of such material be marked in
+ *         reasonable ways as different from the original version.
+ */
+
+#include "pkx/PKFilter.hpp"
+#include "pkx/PKX.hpp"
+#include <algorithm>
+
+namespace
+{
+    template <size_t N>
+    bool contains(const std::bitset<N>& set, size_t value)
+    {
+        return value < N && set[value];
+    }
+}
+
+namespace pksm
+{
+    CompiledPKFilter::CompiledPKFilter(const PKFilter& filter)
+        : speciesSet(filter.speciesValues()),
+          heldItemSet(filter.heldItemValues()),
+          moveSet(filter.moveValues()),
+          abilitySet(filter.abilityValues())
+    {
+        auto add = [this](Field field, bool enabled, bool inverse, u32 value, u8 index = 0)
+        {
+            if (enabled)
+            {
+                checks[count++] = {field, index, inverse, value, value};
+            }
+        };
+
+        add(Field::Generation, filter.generationEnabled(), filter.generationInversed(),
+            u32(filter.generation()));
+        add(Field::Species, filter.speciesEnabled(), filter.speciesInversed(),
+            u32(filter.species()));
+        add(Field::AlternativeForm, filter.alternativeFormEnabled(),
+            filter.alternativeFormInversed(), filter.alternativeForm());
+        add(Field::HeldItem, filter.heldItemEnabled(), filter.heldItemInversed(),
+            filter.heldItem());
+        add(Field::Level, filter.levelEnabled(), filter.levelInversed(), filter.level());
+        add(Field::Ability, filter.abilityEnabled(), filter.abilityInversed(),
+            u32(filter.ability()));
+        add(Field::TSV, filter.TSVEnabled(), filter.TSVInversed(), filter.TSV());
+        add(Field::Nature, filter.natureEnabled(), filter.natureInversed(), u32(filter.nature()));
+        add(Field::Gender, filter.genderEnabled(), filter.genderInversed(), u32(filter.gender()));
+        add(Field::Ball, filter.ballEnabled(), filter.ballInversed(), u32(filter.ball()));
+        add(Field::Language, filter.languageEnabled(), filter.languageInversed(),
+            u32(filter.language()));
+        add(Field::Egg, filter.eggEnabled(), filter.eggInversed(), filter.egg());
+        add(Field::Shiny, filter.shinyEnabled(), filter.shinyInversed(), filter.shiny());
+        for (u8 i = 0; i < 4; i++)
+        {
+            add(Field::Move, filter.moveEnabled(i), filter.moveInversed(i), u32(filter.move(i)),
+                i);
+            add(Field::RelearnMove, filter.relearnMoveEnabled(i), filter.relearnMoveInversed(i),
+                u32(filter.relearnMove(i)), i);
+            needsRelearnMoves |= filter.relearnMoveEnabled(i);
+        }
+        for (u8 i = 0; i < 6; i++)
+        {
+            add(Field::Iv, filter.ivEnabled(Stat(i)), filter.ivInversed(Stat(i)),
+                filter.iv(Stat(i)), i);
+        }
+
+        add(Field::SpeciesSet, filter.speciesInEnabled(), filter.speciesInInversed(), 0);
+        add(Field::HeldItemSet, filter.heldItemInEnabled(), filter.heldItemInInversed(), 0);
+        add(Field::AbilitySet, filter.abilityInEnabled(), filter.abilityInInversed(), 0);
+        add(Field::MoveSet, filter.moveInEnabled(), filter.moveInInversed(), 0);
+        if (filter.levelRangeEnabled())
+        {
+            checks[count++] = {Field::LevelRange, 0, filter.levelRangeInversed(),
+                filter.levelMin(), filter.levelMax()};
+        }
+
+        // Cheap fields first, and among those the ones most likely to rule a Pokemon out.
+        // Shininess and level are derived from several fields, level by searching the experience
+        // table, so they go last
+        std::stable_sort(checks.begin(), checks.begin() + count,
+            [](const Check& a, const Check& b) { return a.field < b.field; });
+
+        impossible = needsRelearnMoves && filter.generationEnabled() &&
+                     !filter.generationInversed() && filter.generation() < Generation::SIX;
+    }
+
+    bool CompiledPKFilter::matches(const PKX& pk) const
+    {
+        if (impossible || (needsRelearnMoves && pk.generation() < Generation::SIX))
+        {
+            return false;
+        }
+
+        for (u8 i = 0; i < count; i++)
+        {
+            const Check& check = checks[i];
+            // Whether pk differs from the filter value, or for IVs falls short of it
+            bool differs = false;
+            switch (check.field)
+            {
+                case Field::Generation:
+                    differs = u32(pk.generation()) != check.value;
+                    break;
+                case Field::Species:
+                    differs = u32(pk.species()) != check.value;
+                    break;
+                case Field::SpeciesSet:
+                    differs = !contains(speciesSet, u16(pk.species()));
+                    break;
+                case Field::AlternativeForm:
+                    differs = pk.alternativeForm() != check.value;
+                    break;
+                case Field::HeldItem:
+                    differs = pk.heldItem() != check.value;
+                    break;
+                case Field::HeldItemSet:
+                    differs = !contains(heldItemSet, pk.heldItem());
+                    break;
+                case Field::Move:
+                    differs = u32(pk.move(check.index)) != check.value;
+                    break;
+                case Field::MoveSet:
+                    differs = true;
+                    for (u8 move = 0; move < 4 && differs; move++)
+                    {
+                        differs = !contains(moveSet, u16(pk.move(move)));
+                    }
+                    break;
+                case Field::RelearnMove:
+                    differs = u32(pk.relearnMove(check.index)) != check.value;
+                    break;
+                case Field::Ability:
+                    differs = u32(pk.ability()) != check.value;
+                    break;
+                case Field::AbilitySet:
+                    differs = !contains(abilitySet, u16(pk.ability()));
+                    break;
+                case Field::Ball:
+                    differs = u32(pk.ball()) != check.value;
+                    break;
+                case Field::Nature:
+                    differs = u32(pk.nature()) != check.value;
+                    break;
+                case Field::Iv:
+                    differs = pk.iv(Stat(check.index)) < check.value;
+                    break;
+                case Field::Language:
+                    differs = u32(pk.language()) != check.value;
+                    break;
+                case Field::Gender:
+                    differs = u32(pk.gender()) != check.value;
+                    break;
+                case Field::Egg:
+                    differs = pk.egg() != bool(check.value);
+                    break;
+                case Field::TSV:
+                    differs = pk.TSV() != check.value;
+                    break;
+                case Field::Shiny:
+                    differs = pk.shiny() != bool(check.value);
+                    break;
+                case Field::Level:
+                    differs = pk.level() != check.value;
+                    break;
+                case Field::LevelRange:
+                {
+                    u8 level = pk.level();
+                    differs  = level < check.value || level > check.max;
+                    break;
+                }
+            }
+            if (check.inverse != differs)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::vector<u64> CompiledPKFilter::matches(const std::vector<std::unique_ptr<PKX>>& pks) const
+    {
+        std::vector<u64> ret((pks.size() + 63) / 64);
+        for (size_t i = 0; i < pks.size(); i++)
+        {
+            if (pks[i] && matches(*pks[i]))
+            {
+                ret[i / 64] |= u64(1) << (i % 64);
+            }
+        }
+        return ret;
+    }
+}
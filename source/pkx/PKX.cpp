@@ -243,6 +243,16 @@ namespace pksm
         return table[row][col];
     }
 
+    u8 PKX::levelFromExp(u8 xpType) const
+    {
+        u8 i = 1;
+        while (experience() >= expTable(i, xpType) && ++i < 100)
+        {
+            ;
+        }
+        return i;
+    }
+
     void PKX::reorderMoves(void)
     {
         if (move(3) != Move::None && move(2) == Move::None)
@@ -354,9 +364,10 @@ namespace pksm
 
     void PKX::healPP(void)
     {
+        const Generation gen = generation();
         for (int i = 0; i < 4; i++)
         {
-            PP(i, maxPP(i));
+            PP(i, VersionTables::movePP(gen, move(i), PPUp(i)));
         }
     }
 
@@ -649,6 +660,41 @@ namespace pksm
         {
             return false;
         }
+        if (filter.speciesInEnabled() &&
+            (filter.speciesInInversed() != !filter.speciesIn(species())))
+        {
+            return false;
+        }
+        if (filter.heldItemInEnabled() &&
+            (filter.heldItemInInversed() != !filter.heldItemIn(heldItem())))
+        {
+            return false;
+        }
+        if (filter.abilityInEnabled() &&
+            (filter.abilityInInversed() != !filter.abilityIn(ability())))
+        {
+            return false;
+        }
+        if (filter.moveInEnabled())
+        {
+            bool any = false;
+            for (u8 i = 0; i < 4 && !any; i++)
+            {
+                any = filter.moveIn(move(i));
+            }
+            if (filter.moveInInversed() == any)
+            {
+                return false;
+            }
+        }
+        if (filter.levelRangeEnabled())
+        {
+            const u8 lvl = level();
+            if (filter.levelRangeInversed() != (lvl < filter.levelMin() || lvl > filter.levelMax()))
+            {
+                return false;
+            }
+        }
         return true;
     }
 
@@ -0,0 +1,195 @@
+/*
+ *   This file is part of PKSM-Core
+ *   Copyright (C) 2016-2022 Bernardo Giordano, Admiral Fish, piepie62
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+ *       * Requiring preservation of specified reasonable legal notices or
+ *         author attributions in that material or in the Appropriate Legal
+ *         Notices displayed by works containing it.
+ *       * Prohibiting misrepresentation of the origin of that material,
+ *         or requiring that modified versions of such material be marked in
+ *         reasonable ways as different from the original version.
+ */
+
+#include "sav/CloneDetector.hpp"
+#include "pkx/PB7.hpp"
+#include "pkx/PK3.hpp"
+#include "pkx/PK4.hpp"
+#include "pkx/PK5.hpp"
+#include "pkx/PK6.hpp"
+#include "pkx/PK7.hpp"
+#include "pkx/PK8.hpp"
+#include "utils/executor.hpp"
+#include <algorithm>
+#include <unordered_map>
+
+namespace
+{
+    // 64-bit FNV-1a
+    constexpr u64 FNV_OFFSET = 0xCBF29CE484222325;
+    constexpr u64 FNV_PRIME  = 0x100000001B3;
+
+    u64 fnv(u64 hash, const u8* data, size_t length)
+    {
+        for (size_t i = 0; i < length; i++)
+        {
+            hash = (hash ^ data[i]) * FNV_PRIME;
+        }
+        return hash;
+    }
+
+    u64 fnv(u64 hash, u32 value)
+    {
+        const u8 bytes[4] = {u8(value), u8(value >> 8), u8(value >> 16), u8(value >> 24)};
+        return fnv(hash, bytes, sizeof(bytes));
+    }
+
+    // Bytes of a record that a box slot keeps, leaving out party stats which are recalculated
+    size_t bodyLength(const pksm::PKX& pk)
+    {
+        switch (pk.generation())
+        {
+            case pksm::Generation::THREE:
+                return pksm::PK3::BOX_LENGTH;
+            case pksm::Generation::FOUR:
+                return pksm::PK4::BOX_LENGTH;
+            case pksm::Generation::FIVE:
+                return pksm::PK5::BOX_LENGTH;
+            case pksm::Generation::SIX:
+                return pksm::PK6::BOX_LENGTH;
+            case pksm::Generation::SEVEN:
+                return pksm::PK7::BOX_LENGTH;
+            case pksm::Generation::LGPE:
+                return pksm::PB7::BOX_LENGTH;
+            case pksm::Generation::EIGHT:
+                return pksm::PK8::BOX_LENGTH;
+            // Gen I and II records are rebuilt from the save with their names attached
+            case pksm::Generation::ONE:
+            case pksm::Generation::TWO:
+            case pksm::Generation::UNUSED:
+                break;
+        }
+        return pk.getLength();
+    }
+}
+
+namespace pksm
+{
+    void CloneDetector::add(u32 save, const Sav& sav)
+    {
+        sav.forEachPKM(
+            [&](const PKX& pk, Sav::StorageSlot where)
+            {
+                const u64 generation = fnv(FNV_OFFSET, u32(pk.generation()));
+                const u64 body =
+                    fnv(generation, pk.rawData().data(), std::min<size_t>(bodyLength(pk),
+                                                             pk.rawData().size()));
+                u64 identity = body;
+                if (pk.generation() >= Generation::THREE)
+                {
+                    identity = fnv(generation, pk.encryptionConstant());
+                    identity = fnv(identity, pk.PID());
+                    identity = fnv(identity, u32(pk.TID()) << 16 | pk.SID());
+                }
+                entries.push_back({identity, body, {save, where}});
+            });
+    }
+
+    void CloneDetector::merge(CloneDetector&& other)
+    {
+        if (entries.empty())
+        {
+            entries = std::move(other.entries);
+        }
+        else
+        {
+            entries.insert(entries.end(), other.entries.begin(), other.entries.end());
+        }
+        other.entries.clear();
+    }
+
+    std::vector<CloneDetector::Cluster> CloneDetector::clusters() const
+    {
+        std::unordered_map<u64, std::vector<size_t>> byIdentity;
+        byIdentity.reserve(entries.size());
+        for (size_t i = 0; i < entries.size(); i++)
+        {
+            byIdentity[entries[i].identity].push_back(i);
+        }
+
+        std::vector<std::pair<size_t, Cluster>> found;
+        std::unordered_map<u64, std::vector<size_t>> byBody;
+        auto toCluster = [this](bool exact, const std::vector<size_t>& members)
+        {
+            Cluster ret{exact, {}};
+            ret.records.reserve(members.size());
+            for (size_t i : members)
+            {
+                ret.records.push_back(entries[i].record);
+            }
+            return std::make_pair(members.front(), std::move(ret));
+        };
+        for (const auto& [identity, members] : byIdentity)
+        {
+            if (members.size() < 2)
+            {
+                continue;
+            }
+            byBody.clear();
+            for (size_t i : members)
+            {
+                byBody[entries[i].body].push_back(i);
+            }
+            for (auto& [body, same] : byBody)
+            {
+                if (same.size() > 1)
+                {
+                    found.push_back(toCluster(true, same));
+                }
+            }
+            if (byBody.size() > 1)
+            {
+                found.push_back(toCluster(false, members));
+            }
+        }
+
+        // Hash order isn't stable, so go by where each cluster was first seen
+        std::sort(found.begin(), found.end(),
+            [](const auto& a, const auto& b)
+            { return a.first != b.first ? a.first < b.first : a.second.exact > b.second.exact; });
+        std::vector<Cluster> ret;
+        ret.reserve(found.size());
+        for (auto& [first, cluster] : found)
+        {
+            ret.push_back(std::move(cluster));
+        }
+        return ret;
+    }
+
+    CloneDetector CloneDetector::scan(const std::vector<std::pair<u32, const Sav*>>& saves)
+    {
+        std::vector<CloneDetector> shards(saves.size());
+        executor()->parallelFor(
+            saves.size(), [&](size_t i) { shards[i].add(saves[i].first, *saves[i].second); });
+
+        CloneDetector ret;
+        for (CloneDetector& shard : shards)
+        {
+            ret.merge(std::move(shard));
+        }
+        return ret;
+    }
+}
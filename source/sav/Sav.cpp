@@ -51,36 +51,243 @@
 #include "sav/SavSWSH.hpp"
 #include "sav/SavUSUM.hpp"
 #include "sav/SavXY.hpp"
+#include "sav/TransferTable.hpp"
 #include "utils/crypto.hpp"
 #include "utils/endian.hpp"
-#include "utils/ValueConverter.hpp"
+#include "utils/executor.hpp"
+#include "utils/io.hpp"
+#include "utils/random.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <optional>
+#include <variant>
+
+#ifndef _PKSMCORE_CONFIGURED
+#include "PKSMCORE_CONFIG.h"
+#endif
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+    // Large enough to hold any stored record
+    constexpr size_t MAX_RECORD_LENGTH = pksm::PK8::PARTY_LENGTH;
+    // Granularity at which snapshots share data
+    constexpr size_t SNAPSHOT_PAGE = 0x1000;
+
+    std::pair<u16, u16> storedLengths(pksm::Generation gen)
+    {
+        switch (gen)
+        {
+            case pksm::Generation::THREE:
+                return {pksm::PK3::BOX_LENGTH, pksm::PK3::PARTY_LENGTH};
+            case pksm::Generation::FOUR:
+                return {pksm::PK4::BOX_LENGTH, pksm::PK4::PARTY_LENGTH};
+            case pksm::Generation::FIVE:
+                return {pksm::PK5::BOX_LENGTH, pksm::PK5::PARTY_LENGTH};
+            case pksm::Generation::SIX:
+                return {pksm::PK6::BOX_LENGTH, pksm::PK6::PARTY_LENGTH};
+            case pksm::Generation::SEVEN:
+                return {pksm::PK7::BOX_LENGTH, pksm::PK7::PARTY_LENGTH};
+            // Boxes store party-sized records in these
+            case pksm::Generation::LGPE:
+                return {pksm::PB7::PARTY_LENGTH, pksm::PB7::PARTY_LENGTH};
+            case pksm::Generation::EIGHT:
+                return {pksm::PK8::PARTY_LENGTH, pksm::PK8::PARTY_LENGTH};
+            // Gen I and II records are never stored contiguously
+            case pksm::Generation::ONE:
+            case pksm::Generation::TWO:
+            case pksm::Generation::UNUSED:
+                return {0, 0};
+        }
+        return {0, 0};
+    }
+
+    pksm::Generation gameGeneration(pksm::Sav::Game game)
+    {
+        switch (game)
+        {
+            case pksm::Sav::Game::RGB:
+            case pksm::Sav::Game::Y:
+                return pksm::Generation::ONE;
+            case pksm::Sav::Game::GS:
+            case pksm::Sav::Game::C:
+                return pksm::Generation::TWO;
+            case pksm::Sav::Game::RS:
+            case pksm::Sav::Game::E:
+            case pksm::Sav::Game::FRLG:
+                return pksm::Generation::THREE;
+            case pksm::Sav::Game::DP:
+            case pksm::Sav::Game::Pt:
+            case pksm::Sav::Game::HGSS:
+                return pksm::Generation::FOUR;
+            case pksm::Sav::Game::BW:
+            case pksm::Sav::Game::B2W2:
+                return pksm::Generation::FIVE;
+            case pksm::Sav::Game::XY:
+            case pksm::Sav::Game::ORAS:
+                return pksm::Generation::SIX;
+            case pksm::Sav::Game::SM:
+            case pksm::Sav::Game::USUM:
+                return pksm::Generation::SEVEN;
+            case pksm::Sav::Game::LGPE:
+                return pksm::Generation::LGPE;
+            case pksm::Sav::Game::SWSH:
+                return pksm::Generation::EIGHT;
+        }
+        return pksm::Generation::UNUSED;
+    }
+
+    using SortValue = std::variant<u32, std::string>;
+
+    SortValue sortValue(const pksm::PKX& pk, pksm::Sav::SortKey key)
+    {
+        switch (key)
+        {
+            case pksm::Sav::SortKey::Species:
+                return u32(pk.species());
+            case pksm::Sav::SortKey::Form:
+                return u32(pk.alternativeForm());
+            case pksm::Sav::SortKey::Level:
+                return u32(pk.level());
+            case pksm::Sav::SortKey::Nature:
+                return u32(pk.nature());
+            case pksm::Sav::SortKey::Gender:
+                return u32(pk.gender());
+            case pksm::Sav::SortKey::Ball:
+                return u32(pk.ball());
+            case pksm::Sav::SortKey::Shiny:
+                return u32(pk.shiny());
+            case pksm::Sav::SortKey::TID:
+                return u32(pk.TID());
+            case pksm::Sav::SortKey::Nickname:
+                return pk.nickname();
+            case pksm::Sav::SortKey::OTName:
+                return pk.otName();
+        }
+        return u32(0);
+    }
+}
 
 namespace pksm
 {
     std::unique_ptr<Sav> Sav::getSave(const std::shared_ptr<u8[]>& dt, size_t length)
     {
+        SaveInfo info = identify(dt.get(), length, length);
+        if (!info.recognized)
+        {
+            return nullptr;
+        }
+
         std::unique_ptr<Sav> ret = nullptr;
+        switch (info.game)
+        {
+            case Game::USUM:
+                ret = std::make_unique<SavUSUM>(dt);
+                break;
+            case Game::SM:
+                ret = std::make_unique<SavSUMO>(dt);
+                break;
+            case Game::ORAS:
+                ret = std::make_unique<SavORAS>(dt);
+                break;
+            case Game::XY:
+                ret = std::make_unique<SavXY>(dt);
+                break;
+            case Game::DP:
+                ret = std::make_unique<SavDP>(dt);
+                break;
+            case Game::Pt:
+                ret = std::make_unique<SavPT>(dt);
+                break;
+            case Game::HGSS:
+                ret = std::make_unique<SavHGSS>(dt);
+                break;
+            case Game::BW:
+                ret = std::make_unique<SavBW>(dt);
+                break;
+            case Game::B2W2:
+                ret = std::make_unique<SavB2W2>(dt);
+                break;
+            case Game::RS:
+                ret = std::make_unique<SavRS>(dt);
+                break;
+            case Game::E:
+                ret = std::make_unique<SavE>(dt);
+                break;
+            case Game::FRLG:
+                ret = std::make_unique<SavFRLG>(dt);
+                break;
+            case Game::GS:
+            case Game::C:
+                ret = std::make_unique<Sav2>(dt, length,
+                    std::tuple<GameVersion, Language, bool>{
+                        info.game == Game::C ? GameVersion::C : GameVersion::GD, info.language,
+                        true});
+                break;
+            case Game::RGB:
+            case Game::Y:
+                ret = std::make_unique<Sav1>(dt, length);
+                break;
+            case Game::LGPE:
+                ret = std::make_unique<SavLGPE>(dt, length);
+                break;
+            case Game::SWSH:
+                ret = std::make_unique<SavSWSH>(dt, length);
+                break;
+        }
+
+        if (ret)
+        {
+            ret->fullLength = length;
+        }
+
+        return ret;
+    }
+
+    Sav::SaveInfo Sav::identify(const ByteSource& source, size_t length)
+    {
+        // Any read that comes up short means there isn't enough data to be sure of anything
+        bool truncated     = false;
+        ByteSource checked = [&](size_t offset, u8* out, size_t size)
+        {
+            if (source(offset, out, size))
+            {
+                return true;
+            }
+            std::fill_n(out, size, 0);
+            truncated = true;
+            return false;
+        };
+
+        SaveInfo info;
+        info.recognized = true;
         switch (length)
         {
             case 0x6CC00:
-                ret = std::make_unique<SavUSUM>(dt);
+                info.game = Game::USUM;
                 break;
             case 0x6BE00:
-                ret = std::make_unique<SavSUMO>(dt);
+                info.game = Game::SM;
                 break;
             case 0x76000:
-                ret = std::make_unique<SavORAS>(dt);
+                info.game = Game::ORAS;
                 break;
             case 0x65600:
-                ret = std::make_unique<SavXY>(dt);
+                info.game = Game::XY;
                 break;
             case 0x80000:
             case 0x8007A:
-                ret = checkDSType(dt);
+                info = identifyDS(checked);
                 break;
             case 0x20000:
             case 0x20010:
-                ret = checkGBAType(dt);
+                info.game = Sav3::getVersion(checked, &info.activePartition);
                 break;
             case 0x8000:
             case 0x10000:
@@ -90,11 +297,29 @@ namespace pksm
             // Emulator standard saves
             case 0x8030:
             case 0x10030:
-                ret = checkGBType(dt, length);
+            {
+                auto [version, language, found] = Sav2::getVersion(checked);
+                if (found)
+                {
+                    info.game     = version == GameVersion::C ? Game::C : Game::GS;
+                    info.language = language;
+                }
+                else
+                {
+                    // Sav1::getVersion can't tell Yellow apart either
+                    info.game = Game::RGB;
+                    // Same box list check as Sav1's constructor
+                    if (Sav2::validList(checked, 0x2ED5, 30) &&
+                        Sav2::validList(checked, 0x302D, 30))
+                    {
+                        info.language = Language::JPN;
+                    }
+                }
                 break;
+            }
             case 0xB8800:
             case 0x100000:
-                ret = std::make_unique<SavLGPE>(dt, length);
+                info.game = Game::LGPE;
                 break;
             case SavSWSH::SIZE_G8SWSH:
             case SavSWSH::SIZE_G8SWSH_1:
@@ -104,54 +329,154 @@ namespace pksm
             case SavSWSH::SIZE_G8SWSH_3A:
             case SavSWSH::SIZE_G8SWSH_3B:
             case SavSWSH::SIZE_G8SWSH_3C:
-                ret = std::make_unique<SavSWSH>(dt, length);
+                info.game = Game::SWSH;
                 break;
             default:
-                ret = std::unique_ptr<Sav>(nullptr);
+                info.recognized = false;
                 break;
         }
 
-        if (ret)
+        if (truncated)
         {
-            ret->fullLength = length;
+            info.truncated  = true;
+            info.recognized = false;
         }
+        if (info.recognized)
+        {
+            info.generation = gameGeneration(info.game);
+        }
+        return info;
+    }
 
-        return ret;
+    Sav::SaveInfo Sav::identify(const u8* data, size_t available, size_t length)
+    {
+        return identify(bufferSource(data, std::min(available, length)), length);
+    }
+
+    Sav::SaveInfo Sav::identify(int fd)
+    {
+        struct stat buffer;
+        if (fstat(fd, &buffer) != 0)
+        {
+            return SaveInfo{};
+        }
+        return identify(
+            [fd](size_t offset, u8* out, size_t size)
+            { return pread(fd, out, size, offset) == ssize_t(size); },
+            buffer.st_size);
     }
 
-    std::unique_ptr<Sav> Sav::checkGBType(const std::shared_ptr<u8[]>& dt, size_t length)
+    Sav::ByteSource Sav::bufferSource(const u8* data, size_t size)
     {
-        std::tuple<GameVersion, Language, bool> versionAndLanguage = Sav2::getVersion(dt);
+        return [data, size](size_t offset, u8* out, size_t count)
+        {
+            if (offset > size || count > size - offset)
+            {
+                return false;
+            }
+            std::copy_n(data + offset, count, out);
+            return true;
+        };
+    }
 
-        if (get<2>(versionAndLanguage))
+#ifdef _PKSMCORE_ENABLE_MMAP
+    std::unique_ptr<Sav> Sav::getSave(const std::string& path)
+    {
+        size_t length              = 0;
+        std::shared_ptr<u8[]> data = io::mapFile(path, length);
+        if (!data)
         {
-            return std::make_unique<Sav2>(dt, length, versionAndLanguage);
+            return nullptr;
         }
+        std::unique_ptr<Sav> ret = getSave(data, length);
+        if (ret)
+        {
+            ret->mappedFrom = path;
+        }
+        return ret;
+    }
 
-        switch (Sav1::getVersion(dt))
+    bool Sav::writeBack(const std::string& path) const
+    {
+        if (path.empty() && mappedFrom.empty())
         {
-            case Game::RGB:
-                return std::make_unique<Sav1>(dt, length);
-            case Game::Y:
-                return std::make_unique<Sav1>(dt, length); // in case anyone wants to
-            default:
-                return std::unique_ptr<Sav>(nullptr);
+            return false;
+        }
+        const std::string& target = path.empty() ? mappedFrom : path;
+        // The page table only says which pages differ from the file the data was mapped from.
+        // Any other file, even one of the same size, has to be compared
+        const bool mapped = !mappedFrom.empty() && io::sameFile(target, mappedFrom);
+        return io::writeChanged(target, data.get(), fullLength, mapped);
+    }
+#endif
+
+    std::future<std::shared_ptr<u8[]>> Sav::finishEditingAsync()
+    {
+        prepareImage();
+        std::shared_ptr<u8[]> image(new u8[fullLength]);
+        std::copy_n(data.get(), fullLength, image.get());
+
+        // std::function needs something copyable
+        auto finish = std::make_shared<std::packaged_task<std::shared_ptr<u8[]>()>>(
+            [this, image]
+            {
+                finishImage(image);
+                return image;
+            });
+        std::future<std::shared_ptr<u8[]>> ret = finish->get_future();
+        executor()->post([finish] { (*finish)(); });
+        return ret;
+    }
+
+    Sav::Snapshot Sav::snapshot()
+    {
+        prepareSnapshot();
+        Snapshot ret;
+        ret.owner = this;
+        ret.state = snapshotState();
+        ret.pages.reserve((fullLength + SNAPSHOT_PAGE - 1) / SNAPSHOT_PAGE);
+        for (size_t offset = 0; offset < fullLength; offset += SNAPSHOT_PAGE)
+        {
+            const size_t i    = offset / SNAPSHOT_PAGE;
+            const size_t size = std::min(SNAPSHOT_PAGE, fullLength - offset);
+            const u8* page    = &data[offset];
+            if (i < snapshotPages.size() && std::equal(page, page + size, snapshotPages[i].get()))
+            {
+                ret.pages.emplace_back(snapshotPages[i]);
+            }
+            else
+            {
+                std::shared_ptr<u8[]> copy(new u8[size]);
+                std::copy_n(page, size, copy.get());
+                ret.pages.emplace_back(std::move(copy));
+            }
         }
+        snapshotPages = ret.pages;
+        return ret;
     }
 
-    std::unique_ptr<Sav> Sav::checkGBAType(const std::shared_ptr<u8[]>& dt)
+    bool Sav::restore(const Snapshot& snapshot)
     {
-        switch (Sav3::getVersion(dt))
+        if (snapshot.owner != this)
         {
-            case Game::RS:
-                return std::make_unique<SavRS>(dt);
-            case Game::E:
-                return std::make_unique<SavE>(dt);
-            case Game::FRLG:
-                return std::make_unique<SavFRLG>(dt);
-            default:
-                return std::unique_ptr<Sav>(nullptr);
+            return false;
+        }
+        prepareSnapshot();
+        for (size_t offset = 0; offset < fullLength; offset += SNAPSHOT_PAGE)
+        {
+            const u8* page    = snapshot.pages[offset / SNAPSHOT_PAGE].get();
+            const size_t size = std::min(SNAPSHOT_PAGE, fullLength - offset);
+            if (!std::equal(page, page + size, &data[offset]))
+            {
+                std::copy_n(page, size, &data[offset]);
+            }
         }
+        snapshotPages = snapshot.pages;
+        restoreState(snapshot.state);
+        invalidateFreeSlots();
+        seenCount   = -1;
+        caughtCount = -1;
+        return true;
     }
 
     bool Sav::isValidDSSave(const std::shared_ptr<u8[]>& dt)
@@ -202,72 +527,87 @@ namespace pksm
         return false;
     }
 
-    std::unique_ptr<Sav> Sav::checkDSType(const std::shared_ptr<u8[]>& dt)
+    Sav::SaveInfo Sav::identifyDS(const ByteSource& source)
     {
-        // Check for block identifiers
-        static constexpr size_t DP_OFFSET   = 0xC100;
-        static constexpr size_t PT_OFFSET   = 0xCF2C;
-        static constexpr size_t HGSS_OFFSET = 0xF628;
-        if (validSequence(dt, DP_OFFSET))
-        {
-            return std::make_unique<SavDP>(dt);
-        }
-        if (validSequence(dt, PT_OFFSET))
-        {
-            return std::make_unique<SavPT>(dt);
-        }
-        if (validSequence(dt, HGSS_OFFSET))
-        {
-            return std::make_unique<SavHGSS>(dt);
-        }
+        // Block identifier footers, and where each game keeps its general block save counters
+        static constexpr std::array<std::tuple<size_t, size_t, Game>, 3> GEN4 = {
+            std::tuple{0xC100, 0xC0EC, Game::DP},
+            std::tuple{0xCF2C, 0xCF18, Game::Pt},
+            std::tuple{0xF628, 0xF614, Game::HGSS}
+        };
 
-        // Check the other save
-        if (validSequence(dt, DP_OFFSET + 0x40000))
+        SaveInfo info;
+        info.recognized = true;
+        for (size_t partition : {0, 0x40000})
         {
-            return std::make_unique<SavDP>(dt);
-        }
-        if (validSequence(dt, PT_OFFSET + 0x40000))
-        {
-            return std::make_unique<SavPT>(dt);
-        }
-        if (validSequence(dt, HGSS_OFFSET + 0x40000))
-        {
-            return std::make_unique<SavHGSS>(dt);
+            for (auto [footer, counters, game] : GEN4)
+            {
+                if (validSequence(source, footer + partition))
+                {
+                    info.game = game;
+                    // Same comparison as Sav4::GBO
+                    Sav4::CountType cmp = Sav4::compareCounters(readSource<u32>(source, counters),
+                        readSource<u32>(source, counters + 0x40000));
+                    if (cmp == Sav4::CountType::SAME)
+                    {
+                        cmp = Sav4::compareCounters(readSource<u32>(source, counters + 4),
+                            readSource<u32>(source, counters + 0x40004));
+                    }
+                    info.activePartition = cmp == Sav4::CountType::SECOND ? 1 : 0;
+                    return info;
+                }
+            }
         }
 
         // Check for BW/B2W2 checksums
-        u16 chk1    = LittleEndian::convertTo<u16>(&dt[0x24000 - 0x100 + 0x8C + 0xE]);
-        u16 actual1 = pksm::crypto::ccitt16({&dt[0x24000 - 0x100], 0x8C});
-        if (chk1 == actual1)
+        u8 block[0x94 + 0x10];
+        source(0x24000 - 0x100, block, 0x8C + 0x10);
+        if (LittleEndian::convertTo<u16>(block + 0x8C + 0xE) ==
+            pksm::crypto::ccitt16({block, 0x8C}))
         {
-            return std::make_unique<SavBW>(dt);
+            info.game = Game::BW;
+            return info;
         }
-        u16 chk2    = LittleEndian::convertTo<u16>(&dt[0x26000 - 0x100 + 0x94 + 0xE]);
-        u16 actual2 = pksm::crypto::ccitt16({&dt[0x26000 - 0x100], 0x94});
-        if (chk2 == actual2)
+        source(0x26000 - 0x100, block, 0x94 + 0x10);
+        if (LittleEndian::convertTo<u16>(block + 0x94 + 0xE) ==
+            pksm::crypto::ccitt16({block, 0x94}))
         {
-            return std::make_unique<SavB2W2>(dt);
+            info.game = Game::B2W2;
+            return info;
         }
-        return nullptr;
+
+        info.recognized = false;
+        return info;
     }
 
     bool Sav::validSequence(const std::shared_ptr<u8[]>& dt, size_t offset)
+    {
+        // The caller vouches for the buffer being large enough
+        return validSequence(bufferSource(dt.get(), std::numeric_limits<size_t>::max()), offset);
+    }
+
+    bool Sav::validSequence(const ByteSource& source, size_t offset)
     {
         static constexpr u32 DATE_INTERNATIONAL = 0x20060623;
         static constexpr u32 DATE_KOREAN        = 0x20070903;
 
-        if (LittleEndian::convertTo<u32>(&dt[offset - 0xC]) != (offset & 0xFFFF))
+        if (readSource<u32>(source, offset - 0xC) != (offset & 0xFFFF))
         {
             return false;
         }
 
-        return LittleEndian::convertTo<u32>(&dt[offset - 0x8]) == DATE_INTERNATIONAL ||
-               LittleEndian::convertTo<u32>(&dt[offset - 0x8]) == DATE_KOREAN;
+        u32 date = readSource<u32>(source, offset - 0x8);
+        return date == DATE_INTERNATIONAL || date == DATE_KOREAN;
     }
 
     std::unique_ptr<PKX> Sav::transfer(const PKX& pk)
     {
-        switch (generation())
+        return transfer(pk, generation());
+    }
+
+    std::unique_ptr<PKX> Sav::transfer(const PKX& pk, Generation generation)
+    {
+        switch (generation)
         {
             case Generation::ONE:
                 return pk.convertToG1(*this);
@@ -293,28 +633,634 @@ namespace pksm
         return nullptr;
     }
 
+    std::vector<Sav::TransferResult> Sav::transferMany(
+        std::span<const PKX* const> pks, bool applyTrade, size_t threads)
+    {
+        const GameVersion target    = version();
+        const Generation generation = this->generation();
+        std::vector<TransferResult> results(pks.size(), {BadTransferReason::OKAY, -1});
+        std::vector<std::unique_ptr<PKX>> converted(pks.size());
+
+        // The tables for every source generation in the batch are looked up before the work is
+        // split up, so the checks don't contend for them
+        std::array<const TransferTable*, 10> tables{};
+        const auto tableIndex = [&tables](const PKX& pk)
+        { return std::min(size_t(pk.generation()), tables.size() - 1); };
+        for (const PKX* pk : pks)
+        {
+            if (!tables[tableIndex(*pk)])
+            {
+                tables[tableIndex(*pk)] = &TransferTable::get(pk->generation(), target);
+            }
+        }
+
+        // Conversions draw from the random number generator of whichever thread runs them. Seeds
+        // for each of them come from the caller's generator instead, so that the results only
+        // depend on how it was seeded and not on threads. Those draws are all the caller's
+        // generator sees of the batch
+        std::vector<u32> seeds(pks.size());
+        for (u32& seed : seeds)
+        {
+            seed = randomNumber(0, std::numeric_limits<u32>::max());
+        }
+
+        // Conversions only read from the save, so they can run side by side
+        auto convertRange = [&](size_t begin, size_t end)
+        {
+            // Executor threads run other work too, so their generators are left as they were
+            RandomStateGuard guard;
+            for (size_t i = begin; i < end; i++)
+            {
+                results[i].reason = tables[tableIndex(*pks[i])]->check(*pks[i]);
+                if (results[i].reason == BadTransferReason::OKAY)
+                {
+                    seedRand(seeds[i]);
+                    converted[i] = transfer(*pks[i], generation);
+                    if (!converted[i])
+                    {
+                        results[i].reason = BadTransferReason::CONVERSION;
+                    }
+                }
+            }
+        };
+        if (threads > 1 && pks.size() > 1)
+        {
+            const size_t chunk = (pks.size() + threads - 1) / threads;
+            executor()->parallelFor((pks.size() + chunk - 1) / chunk,
+                [&](size_t i) { convertRange(i * chunk, std::min((i + 1) * chunk, pks.size())); });
+        }
+        else
+        {
+            convertRange(0, pks.size());
+        }
+
+        int slot = firstFreeSlot();
+        for (size_t i = 0; i < pks.size() && slot != -1; i++)
+        {
+            if (converted[i])
+            {
+                pkm(*converted[i], u8(slot / 30), u8(slot % 30), applyTrade);
+                results[i].slot = slot;
+                slot            = firstFreeSlot(slot + 1);
+            }
+        }
+        return results;
+    }
+
     void Sav::fixParty()
     {
-        // Poor man's bubble sort-like thing
-        int numPkm = 6;
-        for (int i = 5; i > 0; i--)
+        bool occupied[6];
+        for (u8 i = 0; i < 6; i++)
+        {
+            occupied[i] = pkm(i)->species() != Species::None;
+        }
+        int numPkm = compactSlots(
+            6, [&](int i) { return occupied[i]; }, [this](int a, int b) { swapPartySlots(a, b); });
+        // An empty party still reports one member, as it always has
+        partyCount(std::max(numPkm, 1));
+    }
+
+    void Sav::swapPartySlots(u8 a, u8 b)
+    {
+        const u16 length = storedLengths(generation()).second;
+        std::swap_ranges(
+            &data[partyOffset(a)], &data[partyOffset(a)] + length, &data[partyOffset(b)]);
+    }
+
+    u8 Sav::boxSlots(u8 box) const
+    {
+        return std::clamp(maxSlot() - box * 30, 0, 30);
+    }
+
+    u16 Sav::boxSlotSize() const
+    {
+        return storedLengths(generation()).first;
+    }
+
+    void Sav::readBoxSlot(u8 box, u8 slot, u8* out) const
+    {
+        std::copy_n(&data[boxOffset(box, slot)], boxSlotSize(), out);
+    }
+
+    void Sav::writeBoxSlot(u8 box, u8 slot, const u8* in)
+    {
+        std::copy_n(in, boxSlotSize(), &data[boxOffset(box, slot)]);
+    }
+
+    void Sav::sortBoxes(
+        u8 firstBox, u8 lastBox, const std::vector<SortCriterion>& keys, bool stable)
+    {
+        std::vector<StorageSlot> slots;
+        for (int box = firstBox; box <= std::min(int(lastBox), maxBoxes() - 1); box++)
+        {
+            for (u8 slot = 0; slot < boxSlots(box); slot++)
+            {
+                slots.push_back({u8(box), slot});
+            }
+        }
+        if (slots.empty())
+        {
+            return;
+        }
+
+        // One pass to copy every slot out and pull its keys
+        const u16 size         = boxSlotSize();
+        const u16 recordLength = storedLengths(generation()).first;
+        std::vector<u8> stored(slots.size() * size);
+        std::vector<SortValue> values(slots.size() * keys.size());
+        std::vector<bool> occupied(slots.size());
+        u8 scratch[MAX_RECORD_LENGTH];
+        for (size_t i = 0; i < slots.size(); i++)
+        {
+            u8* blob = &stored[i * size];
+            readBoxSlot(slots[i].box, slots[i].slot, blob);
+            auto pk = slotView({slots[i], recordLength ? blob : nullptr, recordLength}, scratch);
+            occupied[i] = pk->species() != Species::None;
+            if (occupied[i])
+            {
+                for (size_t key = 0; key < keys.size(); key++)
+                {
+                    values[i * keys.size() + key] = sortValue(*pk, keys[key].key);
+                }
+            }
+        }
+
+        std::vector<size_t> order(slots.size());
+        std::iota(order.begin(), order.end(), 0);
+        auto compare = [&](size_t a, size_t b)
+        {
+            if (occupied[a] != occupied[b] || !occupied[a])
+            {
+                return bool(occupied[a]) && !occupied[b];
+            }
+            for (size_t key = 0; key < keys.size(); key++)
+            {
+                auto cmp = values[a * keys.size() + key] <=> values[b * keys.size() + key];
+                if (cmp != 0)
+                {
+                    return keys[key].descending ? cmp > 0 : cmp < 0;
+                }
+            }
+            return false;
+        };
+        if (stable)
+        {
+            std::stable_sort(order.begin(), order.end(), compare);
+        }
+        else
+        {
+            std::sort(order.begin(), order.end(), compare);
+        }
+
+        for (size_t i = 0; i < slots.size(); i++)
+        {
+            writeBoxSlot(slots[i].box, slots[i].slot, &stored[order[i] * size]);
+        }
+        boxSlotsMoved(slots, order);
+        invalidateFreeSlots();
+    }
+
+    std::vector<Sav::StoredSlot> Sav::storageTable() const
+    {
+        auto [boxLength, partyLength] = storedLengths(generation());
+        std::vector<StoredSlot> ret;
+        ret.reserve(6 + maxSlot());
+        for (u8 slot = 0; slot < std::min(partyCount(), u8(6)); slot++)
+        {
+            ret.push_back({{StorageSlot::PARTY, slot}, &data[partyOffset(slot)], partyLength});
+        }
+        for (int i = 0; i < maxSlot(); i++)
+        {
+            ret.push_back({{u8(i / 30), u8(i % 30)}, &data[boxOffset(i / 30, i % 30)], boxLength});
+        }
+        return ret;
+    }
+
+    std::unique_ptr<PKX> Sav::slotView(const StoredSlot& slot, u8* scratch) const
+    {
+        if (slot.raw)
+        {
+            // Copied so that decrypting the view never touches the save
+            std::copy_n(slot.raw, slot.length, scratch);
+            return PKX::getPKM(generation(), scratch, slot.length, true);
+        }
+        return slot.where.isParty() ? pkm(slot.where.slot) : pkm(slot.where.box, slot.where.slot);
+    }
+
+    void Sav::forEachPKM(const PKMVisitor& visitor, size_t threads) const
+    {
+        const std::vector<StoredSlot> table = storageTable();
+        auto visitRange                     = [&](size_t begin, size_t end)
+        {
+            u8 scratch[MAX_RECORD_LENGTH];
+            for (size_t i = begin; i < end; i++)
+            {
+                auto pk = slotView(table[i], scratch);
+                if (pk->species() != Species::None)
+                {
+                    visitor(*pk, table[i].where);
+                }
+            }
+        };
+
+        threads = std::clamp(threads, size_t(1), table.size());
+        if (threads > 1)
+        {
+            const size_t chunk = (table.size() + threads - 1) / threads;
+            executor()->parallelFor((table.size() + chunk - 1) / chunk,
+                [&](size_t i)
+                { visitRange(i * chunk, std::min((i + 1) * chunk, table.size())); });
+        }
+        else
+        {
+            visitRange(0, table.size());
+        }
+    }
+
+    void Sav::editEachPKM(const PKMEditor& editor)
+    {
+        u8 scratch[MAX_RECORD_LENGTH];
+        for (const StoredSlot& slot : storageTable())
+        {
+            auto pk = slotView(slot, scratch);
+            if (pk->species() == Species::None || !editor(*pk, slot.where))
+            {
+                continue;
+            }
+            pk->refreshChecksum();
+
+            if (slot.raw && slot.where.isParty())
+            {
+                // Same storage rules as pkm(): party data is encrypted
+                pk->encrypt();
+                std::copy_n(scratch, slot.length, slot.raw);
+            }
+            else if (slot.raw)
+            {
+                // Box data is not, and may be kept in more than one place
+                writeBoxSlot(slot.where.box, slot.where.slot, scratch);
+            }
+            else if (slot.where.isParty())
+            {
+                pkm(*pk, slot.where.slot);
+            }
+            else
+            {
+                pkm(*pk, slot.where.box, slot.where.slot, false);
+            }
+        }
+    }
+
+    void Sav::healPP(u8 firstBox, u8 lastBox, bool party)
+    {
+        editEachPKM(
+            [&](PKX& pk, StorageSlot where)
+            {
+                if (where.isParty() ? !party : where.box < firstBox || where.box > lastBox)
+                {
+                    return false;
+                }
+                const Generation gen = pk.generation();
+                bool changed         = false;
+                for (u8 i = 0; i < 4; i++)
+                {
+                    const u8 pp = VersionTables::movePP(gen, pk.move(i), pk.PPUp(i));
+                    if (pk.PP(i) != pp)
+                    {
+                        pk.PP(i, pp);
+                        changed = true;
+                    }
+                }
+                return changed;
+            });
+    }
+
+    std::vector<u64> Sav::findPKM(const PKFilter& filter, size_t threads) const
+    {
+        const CompiledPKFilter compiled(filter);
+        // A byte per slot so that concurrent visitors never share a word
+        std::vector<u8> hits(maxBoxes() * 30);
+        forEachPKM(
+            [&](const PKX& pk, StorageSlot where)
+            {
+                if (!where.isParty() && compiled.matches(pk))
+                {
+                    hits[where.box * 30 + where.slot] = 1;
+                }
+            },
+            threads);
+
+        std::vector<u64> ret((hits.size() + 63) / 64);
+        for (size_t i = 0; i < hits.size(); i++)
+        {
+            if (hits[i])
+            {
+                ret[i / 64] |= u64(1) << (i % 64);
+            }
+        }
+        return ret;
+    }
+
+    Sav::DexUpdate::DexUpdate(const Sav& save, Species species)
+        : save(save),
+          species(species),
+          available(save.speciesTable().contains(species)),
+          seen(available && save.getSeen(species)),
+          caught(available && save.getCaught(species))
+    {
+    }
+
+    Sav::DexUpdate::~DexUpdate()
+    {
+        if (!available)
+        {
+            return;
+        }
+        if (!seen && save.seenCount >= 0 && save.getSeen(species))
+        {
+            save.seenCount++;
+        }
+        if (!caught && save.caughtCount >= 0 && save.getCaught(species))
+        {
+            save.caughtCount++;
+        }
+    }
+
+    void Sav::dex(const PKX& pk)
+    {
+        DexUpdate update{*this, pk.species()};
+        registerDex(pk);
+    }
+
+    std::pair<u64, u32> Sav::dexKey(const PKX& pk) const
+    {
+        const u64 common = u64(pk.species()) | u64(pk.alternativeForm()) << 16 |
+                           u64(pk.gender()) << 32 | u64(pk.shiny()) << 34 |
+                           u64(pk.language()) << 40 | u64(pk.version()) << 48;
+        // Spinda's entry remembers a spot pattern
+        return {common, pk.species() == Species::Spinda ? pk.encryptionConstant() : 0};
+    }
+
+    void Sav::dexAll()
+    {
+        // Key of the last Pokemon registered for each species
+        std::map<Species, std::pair<u64, u32>> registered;
+        u8 scratch[MAX_RECORD_LENGTH];
+        for (const StoredSlot& slot : storageTable())
+        {
+            auto pk = slotView(slot, scratch);
+            if (pk->species() == Species::None || pk->egg())
+            {
+                continue;
+            }
+            const std::pair<u64, u32> key = dexKey(*pk);
+            auto [last, added]            = registered.try_emplace(pk->species(), key);
+            if (added || last->second != key)
+            {
+                last->second = key;
+                registerDex(*pk);
+            }
+        }
+        // Counted again on next use
+        seenCount   = -1;
+        caughtCount = -1;
+    }
+
+    const std::vector<u64>& Sav::occupancy() const
+    {
+        if (occupiedSlots.empty())
+        {
+            occupiedSlots.assign((maxBoxes() * 30 + 63) / 64, 0);
+            // Boxes that hold fewer than 30 have no slots past the end, so those are never free
+            for (int box = 0; box < maxBoxes(); box++)
+            {
+                for (int slot = boxSlots(box); slot < 30; slot++)
+                {
+                    int index = box * 30 + slot;
+                    occupiedSlots[index / 64] |= u64(1) << (index % 64);
+                }
+            }
+            forEachPKM(
+                [this](const PKX&, StorageSlot where)
+                {
+                    if (!where.isParty())
+                    {
+                        int index = where.box * 30 + where.slot;
+                        occupiedSlots[index / 64] |= u64(1) << (index % 64);
+                    }
+                });
+        }
+        return occupiedSlots;
+    }
+
+    void Sav::markSlot(u8 box, u8 slot, bool occupied)
+    {
+        int index = box * 30 + slot;
+        // Nothing to keep current until somebody has asked for it
+        if (occupiedSlots.empty() || index >= maxBoxes() * 30)
+        {
+            return;
+        }
+        if (occupied)
+        {
+            occupiedSlots[index / 64] |= u64(1) << (index % 64);
+        }
+        else
+        {
+            occupiedSlots[index / 64] &= ~(u64(1) << (index % 64));
+        }
+    }
+
+    int Sav::firstFreeSlot(int start) const
+    {
+        const std::vector<u64>& bits = occupancy();
+        start                        = std::max(start, 0);
+        for (size_t word = start / 64; word < bits.size(); word++)
+        {
+            u64 free = ~bits[word];
+            if (word == size_t(start / 64))
+            {
+                free &= ~u64(0) << (start % 64);
+            }
+            if (free != 0)
+            {
+                int index = word * 64 + std::countr_zero(free);
+                return index < maxBoxes() * 30 ? index : -1;
+            }
+        }
+        return -1;
+    }
+
+    std::vector<int> Sav::freeSlots() const
+    {
+        std::vector<int> ret;
+        for (int index = firstFreeSlot(); index != -1; index = firstFreeSlot(index + 1))
+        {
+            ret.push_back(index);
+        }
+        return ret;
+    }
+
+    std::vector<Sav::SaveBlock> Sav::saveBlocks() const
+    {
+        return {{0, 0, length}};
+    }
+
+    Sav::Diff diffSaves(const Sav& before, const Sav& after)
+    {
+        Sav::Diff ret;
+        if (before.game != after.game || before.length != after.length)
+        {
+            ret.comparable = false;
+            return ret;
+        }
+
+        // Where each save's blocks live, and which of those changed, used to skip the records that
+        // can't have changed
+        using Range = std::pair<const u8*, const u8*>;
+        std::vector<Range> oldBlockRanges, newBlockRanges, oldChanged, newChanged;
         {
-            auto checkPKM = pkm(i);
-            if (checkPKM->species() == Species::None)
+            auto range = [](const Sav& save, const Sav::SaveBlock& block)
+            {
+                const u8* begin = block.raw ? block.raw : &save.data[block.offset];
+                return Range{begin, begin + block.length};
+            };
+            std::map<u32, Range> oldBlocks;
+            for (const Sav::SaveBlock& block : before.saveBlocks())
+            {
+                oldBlockRanges.push_back(range(before, block));
+                oldBlocks.emplace(block.id, oldBlockRanges.back());
+            }
+            for (const Sav::SaveBlock& block : after.saveBlocks())
+            {
+                newBlockRanges.push_back(range(after, block));
+                const Range& newRange = newBlockRanges.back();
+                auto found            = oldBlocks.find(block.id);
+                if (found != oldBlocks.end() &&
+                    std::equal(newRange.first, newRange.second, found->second.first,
+                        found->second.second))
+                {
+                    continue;
+                }
+                ret.blocks.push_back(block.id);
+                newChanged.push_back(newRange);
+                if (found != oldBlocks.end())
+                {
+                    oldChanged.push_back(found->second);
+                }
+            }
+        }
+        if (ret.blocks.empty())
+        {
+            return ret;
+        }
+
+        auto touches = [](const std::vector<Range>& blocks, const std::vector<Range>& changed,
+                           const Sav::StoredSlot& slot)
+        {
+            auto overlaps = [&](const Range& range)
+            { return slot.raw < range.second && range.first < slot.raw + slot.length; };
+            // Records kept outside of every block can't be matched up with them
+            if (!slot.raw || std::none_of(blocks.begin(), blocks.end(), overlaps))
+            {
+                return true;
+            }
+            return std::any_of(changed.begin(), changed.end(), overlaps);
+        };
+
+        // Indexed by party slot, then by box * 30 + slot
+        const int slots = 6 + after.maxBoxes() * 30;
+        auto index      = [slots](const Sav& save)
+        {
+            std::vector<Sav::StoredSlot> table = save.storageTable();
+            std::vector<std::optional<Sav::StoredSlot>> indexed(slots);
+            for (const Sav::StoredSlot& slot : table)
+            {
+                indexed[slot.where.isParty() ? slot.where.slot
+                                             : 6 + slot.where.box * 30 + slot.where.slot] = slot;
+            }
+            return indexed;
+        };
+        const auto oldSlots = index(before);
+        const auto newSlots = index(after);
+
+        u8 oldScratch[MAX_RECORD_LENGTH], newScratch[MAX_RECORD_LENGTH];
+        for (int i = 0; i < slots; i++)
+        {
+            const auto& oldSlot = oldSlots[i];
+            const auto& newSlot = newSlots[i];
+            if (!oldSlot && !newSlot)
+            {
+                continue;
+            }
+            if (oldSlot && newSlot && !touches(oldBlockRanges, oldChanged, *oldSlot) &&
+                !touches(newBlockRanges, newChanged, *newSlot))
             {
-                numPkm--;
                 continue;
             }
-            auto prevPKM = pkm(i - 1);
-            if (checkPKM->species() != Species::None && prevPKM->species() == Species::None)
+
+            auto oldPkm = oldSlot ? before.slotView(*oldSlot, oldScratch) : nullptr;
+            auto newPkm = newSlot ? after.slotView(*newSlot, newScratch) : nullptr;
+            const Species oldSpecies = oldPkm ? oldPkm->species() : Species::None;
+            const Species newSpecies = newPkm ? newPkm->species() : Species::None;
+            if (oldPkm && newPkm ? std::ranges::equal(oldPkm->rawData(), newPkm->rawData())
+                                 : oldSpecies == newSpecies)
+            {
+                continue;
+            }
+            ret.pkm.push_back({i < 6 ? Sav::StorageSlot{Sav::StorageSlot::PARTY, u8(i)}
+                                     : Sav::StorageSlot{u8((i - 6) / 30), u8((i - 6) % 30)},
+                oldSpecies, newSpecies});
+        }
+
+        using Field = Sav::Diff::TrainerField;
+        auto check  = [&](Field field, auto get)
+        {
+            if (get(before) != get(after))
+            {
+                ret.trainer.push_back(field);
+            }
+        };
+        check(Field::TID, [](const Sav& save) { return save.TID(); });
+        check(Field::SID, [](const Sav& save) { return save.SID(); });
+        check(Field::Name, [](const Sav& save) { return save.otName(); });
+        check(Field::Gender, [](const Sav& save) { return save.gender(); });
+        check(Field::Language, [](const Sav& save) { return save.language(); });
+        check(Field::Money, [](const Sav& save) { return save.money(); });
+        check(Field::BP, [](const Sav& save) { return save.BP(); });
+        check(Field::Badges, [](const Sav& save) { return save.badges(); });
+        check(Field::PlayTime,
+            [](const Sav& save)
+            {
+                return std::tuple{
+                    save.playedHours(), save.playedMinutes(), save.playedSeconds()};
+            });
+        check(Field::CurrentBox, [](const Sav& save) { return save.currentBox(); });
+
+        std::map<std::pair<Sav::Pouch, u16>, std::pair<u32, u32>> counts;
+        for (const auto& [pouch, size] : after.pouches())
+        {
+            for (int slot = 0; slot < size; slot++)
             {
-                pkm(*checkPKM, i - 1);
-                pkm(*prevPKM, i);
-                numPkm = 6;
-                i      = 6; // reset loop
+                if (auto item = before.item(pouch, slot); item->id() != 0)
+                {
+                    counts[{pouch, item->id()}].first += item->count();
+                }
+                if (auto item = after.item(pouch, slot); item->id() != 0)
+                {
+                    counts[{pouch, item->id()}].second += item->count();
+                }
             }
         }
-        partyCount(numPkm);
+        for (const auto& [key, count] : counts)
+        {
+            if (count.first != count.second)
+            {
+                ret.items.push_back({key.first, key.second, count.first, count.second});
+            }
+        }
+
+        return ret;
     }
 
     u32 Sav::displayTID() const
@@ -361,82 +1307,6 @@ namespace pksm
 
     Sav::BadTransferReason Sav::invalidTransferReason(const PKX& pk) const
     {
-        bool moveBad = false;
-        for (int i = 0; i < 4; i++)
-        {
-            if (availableMoves().count(pk.move(i)) == 0)
-            {
-                moveBad = true;
-                break;
-            }
-            if (availableMoves().count(pk.relearnMove(i)) == 0)
-            {
-                moveBad = true;
-                break;
-            }
-        }
-        if (moveBad)
-        {
-            return BadTransferReason::MOVE;
-        }
-        if (availableSpecies().count(pk.species()) == 0)
-        {
-            return BadTransferReason::SPECIES;
-        }
-        if (pk.alternativeForm() >= formCount(pk.species()) &&
-            !((pk.species() == Species::Scatterbug || pk.species() == Species::Spewpa) &&
-                pk.alternativeForm() < formCount(Species::Vivillon)) &&
-            !((pk.species() == Species::Mothim) &&
-                pk.alternativeForm() < formCount(Species::Burmy)))
-        {
-            return BadTransferReason::FORM;
-        }
-        if (availableAbilities().count(pk.ability()) == 0)
-        {
-            if (generation() > Generation::TWO && pk.generation() > Generation::TWO)
-            {
-                return BadTransferReason::ABILITY;
-            }
-        }
-
-        if (generation() <= Generation::TWO)
-        {
-            const int heldItem2 = pk.generation() == Generation::ONE
-                                    ? (int)static_cast<const PK1&>(pk).heldItem2()
-                                    : (pk.generation() == Generation::TWO
-                                              ? (int)static_cast<const PK2&>(pk).heldItem2()
-                                              : (int)ItemConverter::nationalToG2(pk.heldItem()));
-            // Crystal only adds key items
-            if (VersionTables::availableItems(GameVersion::GD).count(heldItem2) == 0 ||
-                (heldItem2 == 0 && pk.heldItem() != 0))
-            {
-                return BadTransferReason::ITEM;
-            }
-        }
-        else if (generation() == Generation::THREE)
-        {
-            const int heldItem3 = pk.generation() == Generation::THREE
-                                    ? (int)static_cast<const PK3&>(pk).heldItem3()
-                                    : (int)ItemConverter::nationalToG3(pk.heldItem());
-            if (availableItems().count(heldItem3) == 0 || (heldItem3 == 0 && pk.heldItem() != 0))
-            {
-                return BadTransferReason::ITEM;
-            }
-        }
-        else if (availableItems().count((int)pk.heldItem()) == 0 ||
-                 (pk.generation() == Generation::THREE &&
-                     pk.heldItem() == ItemConverter::ITEM_NOT_CONVERTIBLE))
-        {
-            return BadTransferReason::ITEM;
-        }
-
-        if (availableBalls().count(pk.ball()) == 0)
-        {
-            if (generation() > Generation::TWO)
-            {
-                return BadTransferReason::BALL;
-            }
-        }
-        return BadTransferReason::OKAY;
+        return TransferTable::get(pk.generation(), version()).check(pk);
     }
 }
@@ -69,6 +69,9 @@ namespace pksm
         OFS_BANK3_BOX_SUMS = 0x6000 + bankBoxesSize;
 
         originalCurrentBox = currentBox();
+
+        // Each entry is followed by the language guessed for it
+        decodedSlots.reset(maxBoxes() * maxPkmInBox, PK1Length() + 1);
     }
 
     Sav::Game Sav1::getVersion(const std::shared_ptr<u8[]>& dt)
@@ -89,29 +92,94 @@ namespace pksm
         return japanese ? PK1::JP_LENGTH_WITH_NAMES : PK1::INT_LENGTH_WITH_NAMES;
     }
 
-    // ctrl-v the fixparty code, boxes are expected to be contiguous
+    // Boxes are expected to be contiguous
     void Sav1::fixBoxes()
     {
-        // Poor man's bubble sort-like thing
         for (int i = 0; i < maxBoxes(); i++)
         {
-            for (int j = maxPkmInBox - 1; j > 0; j--)
+            if (!(dirtyBoxes & (1 << i)))
             {
-                auto checkPKM = pkm(i, j);
-                if (checkPKM->species() == Species::None)
-                {
-                    continue;
-                }
-                auto prevPKM = pkm(i, j - 1);
-                if (checkPKM->species() != Species::None && prevPKM->species() == Species::None)
-                {
-                    pkm(*checkPKM, i, j - 1, false);
-                    pkm(*prevPKM, i, j, false);
-                    j      = maxPkmInBox; // reset loop
-                }
+                continue;
             }
+            bool occupied[30];
+            for (u8 slot = 0; slot < maxPkmInBox; slot++)
+            {
+                occupied[slot] = pkm(i, slot)->species() != Species::None;
+            }
+            compactSlots(
+                maxPkmInBox, [&](int slot) { return occupied[slot]; },
+                [this, i](int a, int b) { swapBoxSlots(i, a, b); });
             fixBox(i);
         }
+        invalidateFreeSlots();
+    }
+
+    // Moves a slot's record together with its species list entry and both names
+    void Sav1::swapBoxSlots(u8 box, u8 a, u8 b)
+    {
+        std::swap(data[boxStart(box) + 1 + a], data[boxStart(box) + 1 + b]);
+        std::swap_ranges(&data[boxOffset(box, a)], &data[boxOffset(box, a)] + PK1::BOX_LENGTH,
+            &data[boxOffset(box, b)]);
+        std::swap_ranges(&data[boxOtNameOffset(box, a)],
+            &data[boxOtNameOffset(box, a)] + nameLength(), &data[boxOtNameOffset(box, b)]);
+        std::swap_ranges(&data[boxNicknameOffset(box, a)],
+            &data[boxNicknameOffset(box, a)] + nameLength(), &data[boxNicknameOffset(box, b)]);
+        decodedSlots.invalidate(box * maxPkmInBox + a);
+        decodedSlots.invalidate(box * maxPkmInBox + b);
+        markBoxDirty(box);
+    }
+
+    // Species list entry, record, OT name, nickname. Slots past the box count read as empty
+    u16 Sav1::boxSlotSize() const
+    {
+        return 1 + PK1::BOX_LENGTH + 2 * nameLength();
+    }
+
+    void Sav1::readBoxSlot(u8 box, u8 slot, u8* out) const
+    {
+        if (slot >= boxCount(box))
+        {
+            std::fill_n(out, boxSlotSize(), 0);
+            return;
+        }
+        out[0] = data[boxStart(box) + 1 + slot];
+        out    = std::copy_n(&data[boxOffset(box, slot)], PK1::BOX_LENGTH, out + 1);
+        out    = std::copy_n(&data[boxOtNameOffset(box, slot)], nameLength(), out);
+        std::copy_n(&data[boxNicknameOffset(box, slot)], nameLength(), out);
+    }
+
+    void Sav1::writeBoxSlot(u8 box, u8 slot, const u8* in)
+    {
+        data[boxStart(box) + 1 + slot] = in[0];
+        in += 1;
+        std::copy_n(in, PK1::BOX_LENGTH, &data[boxOffset(box, slot)]);
+        in += PK1::BOX_LENGTH;
+        std::copy_n(in, nameLength(), &data[boxOtNameOffset(box, slot)]);
+        in += nameLength();
+        std::copy_n(in, nameLength(), &data[boxNicknameOffset(box, slot)]);
+        decodedSlots.invalidate(box * maxPkmInBox + slot);
+        markBoxDirty(box);
+    }
+
+    void Sav1::boxSlotsMoved(const std::vector<StorageSlot>& slots, const std::vector<size_t>&)
+    {
+        // Empty slots were written as zeroes, so fixBox stops at the right place
+        for (size_t i = 0; i < slots.size(); i += maxPkmInBox)
+        {
+            boxCount(slots[i].box, maxPkmInBox);
+            fixBox(slots[i].box);
+        }
+    }
+
+    void Sav1::swapPartySlots(u8 a, u8 b)
+    {
+        std::swap(data[OFS_PARTY + 1 + a], data[OFS_PARTY + 1 + b]);
+        std::swap_ranges(&data[partyOffset(a)], &data[partyOffset(a)] + PK1::PARTY_LENGTH,
+            &data[partyOffset(b)]);
+        std::swap_ranges(&data[partyOtNameOffset(a)], &data[partyOtNameOffset(a)] + nameLength(),
+            &data[partyOtNameOffset(b)]);
+        std::swap_ranges(&data[partyNicknameOffset(a)],
+            &data[partyNicknameOffset(a)] + nameLength(), &data[partyNicknameOffset(b)]);
     }
 
     void Sav1::finishEditing()
@@ -135,24 +203,38 @@ namespace pksm
             std::copy(&data[boxStart(currentBox())], &data[boxStart(currentBox())] + boxSize,
                 &data[OFS_CURRENT_BOX]);
         }
-        for (int box = 0; box < maxBoxes(); box++)
+        updateBoxSums();
+        data[OFS_MAIN_DATA_SUM] = crypto::diff8({&data[0x2598], mainDataLength});
+
+        originalCurrentBox = currentBox();
+        // Boxes moved in and out of the current box area
+        decodedSlots.invalidateAll();
+        dirtyBoxes = 0;
+    }
+
+    // Box checksums cover the whole box, and each bank's checksum covers exactly its boxes, so
+    // only written boxes have to be summed again and the bank checksums are made from kept sums
+    void Sav1::updateBoxSums()
+    {
+        const int perBank = maxBoxes() / 2;
+        for (int bank = 0; bank < 2; bank++)
         {
-            if (box < (maxBoxes() / 2))
-            {
-                data[OFS_BANK2_BOX_SUMS + 1 + box] =
-                    crypto::diff8({&data[boxDataStart(box, false)], boxSize});
-            }
-            else
+            const int first = bank * perBank;
+            const u16 sums  = bank == 0 ? OFS_BANK2_BOX_SUMS : OFS_BANK3_BOX_SUMS;
+
+            u8 bankSum = 0;
+            for (int box = first; box < first + perBank; box++)
             {
-                data[OFS_BANK3_BOX_SUMS + 1 + (box - (maxBoxes() / 2))] =
-                    crypto::diff8({&data[boxDataStart(box, false)], boxSize});
+                if (dirtyBoxes & (1 << box))
+                {
+                    data[sums + 1 + box - first] =
+                        crypto::diff8({&data[boxStart(box, false)], boxSize});
+                    boxByteSums[box] = ~data[sums + 1 + box - first];
+                }
+                bankSum += boxByteSums[box];
             }
+            data[sums] = ~bankSum;
         }
-        data[OFS_MAIN_DATA_SUM]  = crypto::diff8({&data[0x2598], mainDataLength});
-        data[OFS_BANK2_BOX_SUMS] = crypto::diff8({&data[0x4000], bankBoxesSize});
-        data[OFS_BANK3_BOX_SUMS] = crypto::diff8({&data[0x6000], bankBoxesSize});
-
-        originalCurrentBox = currentBox();
     }
 
     u16 Sav1::TID() const
@@ -175,6 +257,8 @@ namespace pksm
         if (lang != Language::JPN && v != Language::JPN)
         {
             lang = v;
+            // Decoded slots carry a language guessed from their nickname
+            decodedSlots.invalidateAll();
         }
     }
 
@@ -338,26 +422,35 @@ namespace pksm
             return emptyPkm();
         }
 
-        u8 buffer[PK1::INT_LENGTH_WITH_NAMES] = {0x01, data[boxOffset(box, slot)], 0xFF};
-
-        std::copy(
-            &data[boxOffset(box, slot)], &data[boxOffset(box, slot)] + PK1::BOX_LENGTH, buffer + 3);
-        std::copy(&data[boxOtNameOffset(box, slot)],
-            &data[boxOtNameOffset(box, slot)] + nameLength(), buffer + 3 + PK1::PARTY_LENGTH);
-        std::copy(&data[boxNicknameOffset(box, slot)],
-            &data[boxNicknameOffset(box, slot)] + nameLength(),
-            buffer + 3 + PK1::PARTY_LENGTH + nameLength());
-
-        StringUtils::gbStringFailsafe(buffer, 3 + PK1::PARTY_LENGTH, nameLength());
-        StringUtils::gbStringFailsafe(buffer, 3 + PK1::PARTY_LENGTH + nameLength(), nameLength());
+        u8 buffer[PK1::INT_LENGTH_WITH_NAMES + 1];
+        decodedSlots.read(box * maxPkmInBox + slot, buffer,
+            [&](u8* entry)
+            {
+                u8 raw[PK1::INT_LENGTH_WITH_NAMES] = {0x01, data[boxOffset(box, slot)], 0xFF};
+
+                std::copy(&data[boxOffset(box, slot)],
+                    &data[boxOffset(box, slot)] + PK1::BOX_LENGTH, raw + 3);
+                std::copy(&data[boxOtNameOffset(box, slot)],
+                    &data[boxOtNameOffset(box, slot)] + nameLength(), raw + 3 + PK1::PARTY_LENGTH);
+                std::copy(&data[boxNicknameOffset(box, slot)],
+                    &data[boxNicknameOffset(box, slot)] + nameLength(),
+                    raw + 3 + PK1::PARTY_LENGTH + nameLength());
+
+                StringUtils::gbStringFailsafe(raw, 3 + PK1::PARTY_LENGTH, nameLength());
+                StringUtils::gbStringFailsafe(
+                    raw, 3 + PK1::PARTY_LENGTH + nameLength(), nameLength());
+
+                auto pk1 = PKX::getPKM<Generation::ONE>(raw, PK1Length());
+                pk1->updatePartyData();
+                if (language() != Language::JPN)
+                {
+                    pk1->language(StringUtils::guessLanguage12(pk1->nickname()));
+                }
+                *std::ranges::copy(pk1->rawData(), entry).out = u8(pk1->language());
+            });
 
         auto pk1 = PKX::getPKM<Generation::ONE>(buffer, PK1Length());
-        pk1->updatePartyData();
-        if (language() != Language::JPN)
-        {
-            pk1->language(StringUtils::guessLanguage12(pk1->nickname()));
-        }
-
+        pk1->language(Language(buffer[PK1Length()]));
         return pk1;
     }
 
@@ -461,7 +554,29 @@ namespace pksm
                     pk1->rawData().subspan(3 + PK1::PARTY_LENGTH + nameLength(), nameLength()),
                     &data[boxNicknameOffset(box, slot)]);
             }
+
+            decodedSlots.invalidate(box * maxPkmInBox + slot);
+            markBoxDirty(box);
+            markSlot(box, slot, pk.species() != Species::None);
+        }
+    }
+
+    std::vector<Sav::StoredSlot> Sav1::storageTable() const
+    {
+        // Names live in their own lists, so records always have to be put together by pkm()
+        std::vector<StoredSlot> ret;
+        for (u8 slot = 0; slot < std::min(partyCount(), u8(6)); slot++)
+        {
+            ret.push_back({{StorageSlot::PARTY, slot}, nullptr, 0});
+        }
+        for (u8 box = 0; box < maxBoxes(); box++)
+        {
+            for (u8 slot = 0; slot < std::min(boxCount(box), maxPkmInBox); slot++)
+            {
+                ret.push_back({{box, slot}, nullptr, 0});
+            }
         }
+        return ret;
     }
 
     std::unique_ptr<PKX> Sav1::emptyPkm() const
@@ -469,9 +584,9 @@ namespace pksm
         return PKX::getPKM<Generation::ONE>(nullptr, PK1Length());
     }
 
-    void Sav1::dex(const PKX& pk)
+    void Sav1::registerDex(const PKX& pk)
     {
-        if (!(availableSpecies().count(pk.species()) > 0))
+        if (!(speciesTable().count(pk.species()) > 0))
         {
             return;
         }
@@ -509,14 +624,14 @@ namespace pksm
 
     int Sav1::dexSeen() const
     {
-        return std::count_if(availableSpecies().begin(), availableSpecies().end(),
-            [this](const auto& spec) { return getSeen(spec); });
+        return cachedDexCount(seenCount,
+            [this] { return FlagUtil::countFlags({&data[OFS_DEX_SEEN]}, u16(maxSpecies())); });
     }
 
     int Sav1::dexCaught() const
     {
-        return std::count_if(availableSpecies().begin(), availableSpecies().end(),
-            [this](const auto& spec) { return getCaught(spec); });
+        return cachedDexCount(caughtCount,
+            [this] { return FlagUtil::countFlags({&data[OFS_DEX_CAUGHT]}, u16(maxSpecies())); });
     }
 
     u8 Sav1::partyCount() const
@@ -537,6 +652,7 @@ namespace pksm
     void Sav1::boxCount(u8 box, u8 count)
     {
         data[boxStart(box)] = count;
+        markBoxDirty(box);
     }
 
     void Sav1::fixBox(u8 box)
@@ -550,6 +666,7 @@ namespace pksm
         }
         data[boxStart(box) + 1 + count] = 0xFF;
         data[boxStart(box)]             = count;
+        markBoxDirty(box);
     }
 
     void Sav1::fixParty()
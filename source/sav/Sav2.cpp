@@ -173,42 +173,50 @@ namespace pksm
         {
             lang = StringUtils::guessLanguage12(otName());
         }
+
+        // Each entry is followed by the language guessed for it
+        decodedSlots.reset(maxBoxes() * maxPkmInBox, PK2Length() + 1);
     }
 
     std::tuple<GameVersion, Language, bool> Sav2::getVersion(const std::shared_ptr<u8[]>& dt)
+    {
+        return getVersion(bufferSource(dt.get(), 0x8000));
+    }
+
+    std::tuple<GameVersion, Language, bool> Sav2::getVersion(const ByteSource& source)
     {
         GameVersion returnVersion = GameVersion::INVALID;
         Language returnLanguage   = Language::None;
         bool saveFound            = false;
 
-        if (validList(dt, 0x288A, 20) && validList(dt, 0x2D6C, 20))
+        if (validList(source, 0x288A, 20) && validList(source, 0x2D6C, 20))
         {
             returnVersion  = GameVersion::GD;
             returnLanguage = Language::ENG; // as well as all other languages not enumerated
             saveFound      = true;
         }
-        else if (validList(dt, 0x2865, 20) && validList(dt, 0x2D10, 20))
+        else if (validList(source, 0x2865, 20) && validList(source, 0x2D10, 20))
         {
             returnVersion  = GameVersion::C;
             returnLanguage = Language::ENG;
             saveFound      = true;
         }
-        else if (validList(dt, 0x2D10, 30))
+        else if (validList(source, 0x2D10, 30))
         {
-            if (validList(dt, 0x283E, 30))
+            if (validList(source, 0x283E, 30))
             {
                 returnVersion  = GameVersion::GD;
                 returnLanguage = Language::JPN;
                 saveFound      = true;
             }
-            else if (validList(dt, 0x281A, 30))
+            else if (validList(source, 0x281A, 30))
             {
                 returnVersion  = GameVersion::C;
                 returnLanguage = Language::JPN;
                 saveFound      = true;
             }
         }
-        else if (validList(dt, 0x28CC, 20) && validList(dt, 0x2DAE, 20))
+        else if (validList(source, 0x28CC, 20) && validList(source, 0x2DAE, 20))
         {
             returnVersion  = GameVersion::GD;
             returnLanguage = Language::KOR;
@@ -221,7 +229,13 @@ namespace pksm
 
     bool Sav2::validList(const std::shared_ptr<u8[]>& dt, size_t ofs, u8 slot)
     {
-        return (dt[ofs] <= 30) && (dt[ofs + 1 + dt[ofs]] == 0xFF);
+        return validList(bufferSource(dt.get(), 0x8000), ofs, slot);
+    }
+
+    bool Sav2::validList(const ByteSource& source, size_t ofs, u8)
+    {
+        u8 count = readSource<u8>(source, ofs);
+        return (count <= 30) && (readSource<u8>(source, ofs + 1 + count) == 0xFF);
     }
 
     // max length of string + terminator
@@ -237,26 +251,91 @@ namespace pksm
 
     void Sav2::fixBoxes()
     {
-        // Poor man's bubble sort-like thing
         for (int i = 0; i < maxBoxes(); i++)
         {
-            for (int j = maxPkmInBox - 1; j > 0; j--)
+            if (!(dirtyBoxes & (1 << i)))
             {
-                auto checkPKM = pkm(i, j);
-                if (checkPKM->species() == Species::None)
-                {
-                    continue;
-                }
-                auto prevPKM = pkm(i, j - 1);
-                if (checkPKM->species() != Species::None && prevPKM->species() == Species::None)
-                {
-                    pkm(*checkPKM, i, j - 1, false);
-                    pkm(*prevPKM, i, j, false);
-                    j = maxPkmInBox; // reset loop
-                }
+                continue;
             }
+            bool occupied[30];
+            for (u8 slot = 0; slot < maxPkmInBox; slot++)
+            {
+                occupied[slot] = pkm(i, slot)->species() != Species::None;
+            }
+            compactSlots(
+                maxPkmInBox, [&](int slot) { return occupied[slot]; },
+                [this, i](int a, int b) { swapBoxSlots(i, a, b); });
             fixBox(i);
         }
+        invalidateFreeSlots();
+    }
+
+    // Moves a slot's record together with its species list entry and both names
+    void Sav2::swapBoxSlots(u8 box, u8 a, u8 b)
+    {
+        std::swap(data[boxStart(box) + 1 + a], data[boxStart(box) + 1 + b]);
+        std::swap_ranges(&data[boxOffset(box, a)], &data[boxOffset(box, a)] + PK2::BOX_LENGTH,
+            &data[boxOffset(box, b)]);
+        std::swap_ranges(&data[boxOtNameOffset(box, a)],
+            &data[boxOtNameOffset(box, a)] + nameLength(), &data[boxOtNameOffset(box, b)]);
+        std::swap_ranges(&data[boxNicknameOffset(box, a)],
+            &data[boxNicknameOffset(box, a)] + nameLength(), &data[boxNicknameOffset(box, b)]);
+        decodedSlots.invalidate(box * maxPkmInBox + a);
+        decodedSlots.invalidate(box * maxPkmInBox + b);
+        markBoxDirty(box);
+    }
+
+    // Species list entry, record, OT name, nickname. Slots past the box count read as empty
+    u16 Sav2::boxSlotSize() const
+    {
+        return 1 + PK2::BOX_LENGTH + 2 * nameLength();
+    }
+
+    void Sav2::readBoxSlot(u8 box, u8 slot, u8* out) const
+    {
+        if (slot >= boxCount(box))
+        {
+            std::fill_n(out, boxSlotSize(), 0);
+            return;
+        }
+        out[0] = data[boxStart(box) + 1 + slot];
+        out    = std::copy_n(&data[boxOffset(box, slot)], PK2::BOX_LENGTH, out + 1);
+        out    = std::copy_n(&data[boxOtNameOffset(box, slot)], nameLength(), out);
+        std::copy_n(&data[boxNicknameOffset(box, slot)], nameLength(), out);
+    }
+
+    void Sav2::writeBoxSlot(u8 box, u8 slot, const u8* in)
+    {
+        data[boxStart(box) + 1 + slot] = in[0];
+        in += 1;
+        std::copy_n(in, PK2::BOX_LENGTH, &data[boxOffset(box, slot)]);
+        in += PK2::BOX_LENGTH;
+        std::copy_n(in, nameLength(), &data[boxOtNameOffset(box, slot)]);
+        in += nameLength();
+        std::copy_n(in, nameLength(), &data[boxNicknameOffset(box, slot)]);
+        decodedSlots.invalidate(box * maxPkmInBox + slot);
+        markBoxDirty(box);
+    }
+
+    void Sav2::boxSlotsMoved(const std::vector<StorageSlot>& slots, const std::vector<size_t>&)
+    {
+        // Empty slots were written as zeroes, so fixBox stops at the right place
+        for (size_t i = 0; i < slots.size(); i += maxPkmInBox)
+        {
+            boxCount(slots[i].box, maxPkmInBox);
+            fixBox(slots[i].box);
+        }
+    }
+
+    void Sav2::swapPartySlots(u8 a, u8 b)
+    {
+        std::swap(data[OFS_PARTY + 1 + a], data[OFS_PARTY + 1 + b]);
+        std::swap_ranges(&data[partyOffset(a)], &data[partyOffset(a)] + PK2::PARTY_LENGTH,
+            &data[partyOffset(b)]);
+        std::swap_ranges(&data[partyOtNameOffset(a)], &data[partyOtNameOffset(a)] + nameLength(),
+            &data[partyOtNameOffset(b)]);
+        std::swap_ranges(&data[partyNicknameOffset(a)],
+            &data[partyNicknameOffset(a)] + nameLength(), &data[partyNicknameOffset(b)]);
     }
 
     void Sav2::finishEditing()
@@ -281,6 +360,9 @@ namespace pksm
         LittleEndian::convertFrom<u16>(&data[OFS_CHECKSUM_TWO], checksum);
 
         originalCurrentBox = currentBox();
+        // Boxes moved in and out of the current box area
+        decodedSlots.invalidateAll();
+        dirtyBoxes = 0;
     }
 
     u16 Sav2::TID() const
@@ -345,6 +427,8 @@ namespace pksm
             ((lang == Language::KOR) == (v == Language::KOR)))
         {
             lang = v;
+            // Decoded slots carry a language guessed from their nickname
+            decodedSlots.invalidateAll();
         }
     }
 
@@ -534,31 +618,40 @@ namespace pksm
             return emptyPkm();
         }
 
-        u8 buffer[PK2::INT_LENGTH_WITH_NAMES] = {0x01, data[boxStart(box) + 1 + slot], 0xFF};
+        u8 buffer[PK2::INT_LENGTH_WITH_NAMES + 1];
+        decodedSlots.read(box * maxPkmInBox + slot, buffer,
+            [&](u8* entry)
+            {
+                u8 raw[PK2::INT_LENGTH_WITH_NAMES] = {0x01, data[boxStart(box) + 1 + slot], 0xFF};
 
-        std::copy(
-            &data[boxOffset(box, slot)], &data[boxOffset(box, slot)] + PK2::BOX_LENGTH, buffer + 3);
-        std::copy(&data[boxOtNameOffset(box, slot)],
-            &data[boxOtNameOffset(box, slot)] + nameLength(), buffer + 3 + PK2::PARTY_LENGTH);
-        std::copy(&data[boxNicknameOffset(box, slot)],
-            &data[boxNicknameOffset(box, slot)] + nameLength(),
-            buffer + 3 + PK2::PARTY_LENGTH + nameLength());
+                std::copy(&data[boxOffset(box, slot)],
+                    &data[boxOffset(box, slot)] + PK2::BOX_LENGTH, raw + 3);
+                std::copy(&data[boxOtNameOffset(box, slot)],
+                    &data[boxOtNameOffset(box, slot)] + nameLength(), raw + 3 + PK2::PARTY_LENGTH);
+                std::copy(&data[boxNicknameOffset(box, slot)],
+                    &data[boxNicknameOffset(box, slot)] + nameLength(),
+                    raw + 3 + PK2::PARTY_LENGTH + nameLength());
 
-        StringUtils::gbStringFailsafe(buffer, 3 + PK2::PARTY_LENGTH, nameLength());
-        StringUtils::gbStringFailsafe(buffer, 3 + PK2::PARTY_LENGTH + nameLength(), nameLength());
+                StringUtils::gbStringFailsafe(raw, 3 + PK2::PARTY_LENGTH, nameLength());
+                StringUtils::gbStringFailsafe(
+                    raw, 3 + PK2::PARTY_LENGTH + nameLength(), nameLength());
 
-        auto pk2 = PKX::getPKM<Generation::TWO>(buffer, PK2Length());
-        pk2->updatePartyData();
+                auto pk2 = PKX::getPKM<Generation::TWO>(raw, PK2Length());
+                pk2->updatePartyData();
 
-        if (language() == Language::KOR)
-        {
-            pk2->language(Language::KOR);
-        }
-        else if (language() != Language::JPN)
-        {
-            pk2->language(StringUtils::guessLanguage12(pk2->nickname()));
-        }
+                if (language() == Language::KOR)
+                {
+                    pk2->language(Language::KOR);
+                }
+                else if (language() != Language::JPN)
+                {
+                    pk2->language(StringUtils::guessLanguage12(pk2->nickname()));
+                }
+                *std::ranges::copy(pk2->rawData(), entry).out = u8(pk2->language());
+            });
 
+        auto pk2 = PKX::getPKM<Generation::TWO>(buffer, PK2Length());
+        pk2->language(Language(buffer[PK2Length()]));
         return pk2;
     }
 
@@ -668,17 +761,39 @@ namespace pksm
             }
 
             data[boxStart(box) + 1 + slot] = pk2->rawData()[1];
+
+            decodedSlots.invalidate(box * maxPkmInBox + slot);
+            markBoxDirty(box);
+            markSlot(box, slot, pk.species() != Species::None);
         }
     }
 
+    std::vector<Sav::StoredSlot> Sav2::storageTable() const
+    {
+        // Names live in their own lists, so records always have to be put together by pkm()
+        std::vector<StoredSlot> ret;
+        for (u8 slot = 0; slot < std::min(partyCount(), u8(6)); slot++)
+        {
+            ret.push_back({{StorageSlot::PARTY, slot}, nullptr, 0});
+        }
+        for (u8 box = 0; box < maxBoxes(); box++)
+        {
+            for (u8 slot = 0; slot < std::min(boxCount(box), maxPkmInBox); slot++)
+            {
+                ret.push_back({{box, slot}, nullptr, 0});
+            }
+        }
+        return ret;
+    }
+
     std::unique_ptr<PKX> Sav2::emptyPkm() const
     {
         return PKX::getPKM<Generation::TWO>(nullptr, PK2Length());
     }
 
-    void Sav2::dex(const PKX& pk)
+    void Sav2::registerDex(const PKX& pk)
     {
-        if (!(availableSpecies().count(pk.species()) > 0))
+        if (!(speciesTable().count(pk.species()) > 0))
         {
             return;
         }
@@ -737,14 +852,14 @@ namespace pksm
 
     int Sav2::dexSeen() const
     {
-        return std::count_if(availableSpecies().begin(), availableSpecies().end(),
-            [this](const auto& spec) { return getSeen(spec); });
+        return cachedDexCount(seenCount,
+            [this] { return FlagUtil::countFlags({&data[OFS_POKEDEX_SEEN]}, u16(maxSpecies())); });
     }
 
     int Sav2::dexCaught() const
     {
-        return std::count_if(availableSpecies().begin(), availableSpecies().end(),
-            [this](const auto& spec) { return getCaught(spec); });
+        return cachedDexCount(caughtCount, [this]
+            { return FlagUtil::countFlags({&data[OFS_POKEDEX_CAUGHT]}, u16(maxSpecies())); });
     }
 
     std::string Sav2::boxName(u8 box) const
@@ -779,6 +894,7 @@ namespace pksm
     void Sav2::boxCount(u8 box, u8 count)
     {
         data[boxStart(box)] = count;
+        markBoxDirty(box);
     }
 
     void Sav2::fixBox(u8 box)
@@ -791,19 +907,23 @@ namespace pksm
                 break;
             }
 
-            if (pkm(box, count)->egg())
-            {
-                data[boxStart(box) + 1 + count] = 0xFD;
-            }
-            else
+            u8 listed = pkm(box, count)->egg() ? 0xFD : data[boxOffset(box, count)];
+            if (data[boxStart(box) + 1 + count] != listed)
             {
-                data[boxStart(box) + 1 + count] = data[boxOffset(box, count)];
+                // The species list entry is part of what a decoded slot was built from
+                data[boxStart(box) + 1 + count] = listed;
+                decodedSlots.invalidate(box * maxPkmInBox + count);
             }
 
             count++;
         }
         data[boxStart(box) + 1 + count] = 0xFF;
         data[boxStart(box)]             = count;
+        if (count < maxPkmInBox)
+        {
+            decodedSlots.invalidate(box * maxPkmInBox + count);
+        }
+        markBoxDirty(box);
     }
 
     void Sav2::fixParty()
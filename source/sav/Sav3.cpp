@@ -28,6 +28,7 @@
 #include "pkx/PK3.hpp"
 #include "utils/crypto.hpp"
 #include "utils/endian.hpp"
+#include "utils/executor.hpp"
 #include "utils/flagUtil.hpp"
 #include "utils/i18n.hpp"
 #include "utils/utils.hpp"
@@ -56,17 +57,28 @@ namespace pksm
     }
 
     std::array<int, Sav3::BLOCK_COUNT> Sav3::getBlockOrder(const std::shared_ptr<u8[]>& dt, int ofs)
+    {
+        return getBlockOrder(bufferSource(dt.get(), 0x20000), ofs);
+    }
+
+    std::array<int, Sav3::BLOCK_COUNT> Sav3::getBlockOrder(const ByteSource& source, int ofs)
     {
         std::array<int, BLOCK_COUNT> order;
         for (int i = 0; i < BLOCK_COUNT; i++)
         {
-            order[i] = LittleEndian::convertTo<s16>(&dt[ofs + (i * SIZE_BLOCK) + 0xFF4]);
+            order[i] = readSource<s16>(source, ofs + (i * SIZE_BLOCK) + 0xFF4);
         }
         return order;
     }
 
     int Sav3::getActiveSaveIndex(const std::shared_ptr<u8[]>& dt,
         std::array<int, BLOCK_COUNT>& blockOrder1, std::array<int, BLOCK_COUNT>& blockOrder2)
+    {
+        return getActiveSaveIndex(bufferSource(dt.get(), 0x20000), blockOrder1, blockOrder2);
+    }
+
+    int Sav3::getActiveSaveIndex(const ByteSource& source,
+        std::array<int, BLOCK_COUNT>& blockOrder1, std::array<int, BLOCK_COUNT>& blockOrder2)
     {
         int zeroBlock1 = std::find(blockOrder1.begin(), blockOrder1.end(), 0) - blockOrder1.begin();
         int zeroBlock2 = std::find(blockOrder2.begin(), blockOrder2.end(), 0) - blockOrder2.begin();
@@ -78,18 +90,27 @@ namespace pksm
         {
             return 1;
         }
-        u32 count1 = LittleEndian::convertTo<u32>(&dt[(zeroBlock1 * SIZE_BLOCK) + 0x0FFC]);
-        u32 count2 = LittleEndian::convertTo<u32>(&dt[(zeroBlock2 * SIZE_BLOCK) + 0xEFFC]);
+        u32 count1 = readSource<u32>(source, (zeroBlock1 * SIZE_BLOCK) + 0x0FFC);
+        u32 count2 = readSource<u32>(source, (zeroBlock2 * SIZE_BLOCK) + 0xEFFC);
         return count1 > count2 ? 0 : 1;
     }
 
     Sav::Game Sav3::getVersion(const std::shared_ptr<u8[]>& dt)
+    {
+        return getVersion(bufferSource(dt.get(), 0x20000));
+    }
+
+    Sav::Game Sav3::getVersion(const ByteSource& source, int* activeSave)
     {
         // Get block 0 offset
-        std::array<int, BLOCK_COUNT> o1     = getBlockOrder(dt, 0);
-        std::array<int, BLOCK_COUNT> o2     = getBlockOrder(dt, BLOCK_COUNT * SIZE_BLOCK);
-        int activeSAV                       = getActiveSaveIndex(dt, o1, o2);
+        std::array<int, BLOCK_COUNT> o1     = getBlockOrder(source, 0);
+        std::array<int, BLOCK_COUNT> o2     = getBlockOrder(source, BLOCK_COUNT * SIZE_BLOCK);
+        int activeSAV                       = getActiveSaveIndex(source, o1, o2);
         std::array<int, BLOCK_COUNT>& order = activeSAV == 0 ? o1 : o2;
+        if (activeSave)
+        {
+            *activeSave = activeSAV;
+        }
 
         int ABO = activeSAV * SIZE_BLOCK * BLOCK_COUNT;
 
@@ -97,7 +118,7 @@ namespace pksm
             ((std::find(order.begin(), order.end(), 0) - order.begin()) * SIZE_BLOCK) + ABO;
 
         // Get version
-        u32 gameCode = LittleEndian::convertTo<u32>(&dt[blockOfs0 + 0xAC]);
+        u32 gameCode = readSource<u32>(source, blockOfs0 + 0xAC);
         switch (gameCode)
         {
             case 1:
@@ -109,11 +130,11 @@ namespace pksm
                 // 00 FF 00 00 00 00 00 00 00 FF 00 00 00 00 00 00
                 // ^ byte pattern in Emerald saves, is all zero in Ruby/Sapphire as far as I can
                 // tell. Some saves have had data @ 0x550
-                if (LittleEndian::convertTo<u64>(&dt[blockOfs0 + 0xEE0]) != 0)
+                if (readSource<u64>(source, blockOfs0 + 0xEE0) != 0)
                 {
                     return Game::E;
                 }
-                if (LittleEndian::convertTo<u64>(&dt[blockOfs0 + 0xEE8]) != 0)
+                if (readSource<u64>(source, blockOfs0 + 0xEE8) != 0)
                 {
                     return Game::E;
                 }
@@ -122,9 +143,12 @@ namespace pksm
     }
 
     Sav3::Sav3(const std::shared_ptr<u8[]>& dt, SmallVector<int, 3>&& flagOffsets)
-        : Sav(dt, 0x20000), seenFlagOffsets(std::forward<SmallVector<int, 3>&&>(flagOffsets))
+        : Sav(dt, 0x20000),
+          seenFlagOffsets(std::forward<SmallVector<int, 3>&&>(flagOffsets)),
+          storage(new u8[SIZE_STORAGE]())
     {
         loadBlocks();
+        loadStorage();
 
         // Japanese games are limited to 5 character OT names; any unused characters are 0xFF.
         // 5 for JP, 7 for INT. There's always 1 terminator, thus we can check 0x6-0x7 being 0xFFFF
@@ -156,13 +180,48 @@ namespace pksm
         seenFlagOffsets = seenFlagOffsetsTemp;
     }
 
+    u32 Sav3::storageOffset(u8 box, u8 slot)
+    {
+        // The PC data starts with the current box
+        return 4 + (PK3::BOX_LENGTH * (box * 30 + slot));
+    }
+
+    void Sav3::loadStorage()
+    {
+        for (int i = 5; i < BLOCK_COUNT; i++)
+        {
+            if (blockOfs[i] >= 0)
+            {
+                std::copy_n(
+                    &data[blockOfs[i]], chunkLength[i], &storage[(i - 5) * SIZE_BLOCK_USED]);
+            }
+        }
+    }
+
+    void Sav3::syncStorage(u32 offset, u32 length)
+    {
+        // Split at the ends of sections, as boxOffset describes
+        while (length > 0)
+        {
+            const int block  = 5 + offset / SIZE_BLOCK_USED;
+            const u32 within = offset % SIZE_BLOCK_USED;
+            const u32 count  = std::min(length, SIZE_BLOCK_USED - within);
+            if (blockOfs[block] >= 0)
+            {
+                std::copy_n(&storage[offset], count, &data[blockOfs[block] + within]);
+            }
+            offset += count;
+            length -= count;
+        }
+    }
+
     u16 Sav3::calculateChecksum(std::span<const u8> data)
     {
         u32 sum = pksm::crypto::sum32(data);
         return sum + (sum >> 16);
     }
 
-    void Sav3::resign(void)
+    void Sav3::resign(u8* image) const
     {
         for (int i = 0; i < BLOCK_COUNT; i++)
         {
@@ -172,21 +231,37 @@ namespace pksm
             {
                 continue;
             }
-            u16 chk = calculateChecksum({&data[ofs], chunkLength[index]});
-            LittleEndian::convertFrom<u16>(&data[ofs + 0xFF6], chk);
+            u16 chk = calculateChecksum({&image[ofs], chunkLength[index]});
+            LittleEndian::convertFrom<u16>(&image[ofs + 0xFF6], chk);
         }
 
         // Hall of Fame Checksums
         {
-            u16 chk = calculateChecksum({&data[0x1C000], SIZE_BLOCK_USED});
-            LittleEndian::convertFrom<u16>(&data[0x1CFF4], chk);
+            u16 chk = calculateChecksum({&image[0x1C000], SIZE_BLOCK_USED});
+            LittleEndian::convertFrom<u16>(&image[0x1CFF4], chk);
         }
         {
-            u16 chk = calculateChecksum({&data[0x1D000], SIZE_BLOCK_USED});
-            LittleEndian::convertFrom<u16>(&data[0x1DFF4], chk);
+            u16 chk = calculateChecksum({&image[0x1D000], SIZE_BLOCK_USED});
+            LittleEndian::convertFrom<u16>(&image[0x1DFF4], chk);
         }
     }
 
+    std::vector<Sav::SaveBlock> Sav3::saveBlocks() const
+    {
+        std::vector<SaveBlock> ret;
+        for (int i = 0; i < BLOCK_COUNT; i++)
+        {
+            if (blockOfs[i] >= 0)
+            {
+                ret.push_back({u32(i), u32(blockOfs[i]), chunkLength[i],
+                    i >= 5 ? &storage[(i - 5) * SIZE_BLOCK_USED] : nullptr});
+            }
+        }
+        ret.push_back({BLOCK_COUNT, 0x1C000, SIZE_BLOCK_USED});
+        ret.push_back({BLOCK_COUNT + 1, 0x1D000, SIZE_BLOCK_USED});
+        return ret;
+    }
+
     u32 Sav3::securityKey(void) const
     {
         switch (game)
@@ -407,12 +482,13 @@ namespace pksm
 
     u8 Sav3::currentBox(void) const
     {
-        return data[blockOfs[5]];
+        return storage[0];
     }
 
     void Sav3::currentBox(u8 v)
     {
-        data[blockOfs[5]] = v;
+        storage[0] = v;
+        syncStorage(0, 1);
     }
 
     u32 Sav3::boxOffset(u8 box, u8 slot) const
@@ -436,21 +512,19 @@ namespace pksm
 
     std::unique_ptr<PKX> Sav3::pkm(u8 box, u8 slot) const
     {
-        u32 offset = boxOffset(box, slot);
-        // Is it split?
-        if ((offset % 0x1000) + PK3::BOX_LENGTH > 0xF80)
-        {
-            // Concatenate the data if so
-            u8 pkmData[PK3::BOX_LENGTH];
-            auto nextOut = std::copy(&data[offset], &data[(offset & 0xFFFFF000) | 0xF80], pkmData);
-            u32 nextOffset = boxOffset(box + (slot + 1) / 30, (slot + 1) % 30);
-            std::copy(&data[nextOffset & 0xFFFFF000], &data[nextOffset], nextOut);
-            return PKX::getPKM<Generation::THREE>(pkmData, PK3::BOX_LENGTH);
-        }
-        else
-        {
-            return PKX::getPKM<Generation::THREE>(&data[offset], PK3::BOX_LENGTH);
-        }
+        return PKX::getPKM<Generation::THREE>(
+            &storage[storageOffset(box, slot)], PK3::BOX_LENGTH);
+    }
+
+    void Sav3::readBoxSlot(u8 box, u8 slot, u8* out) const
+    {
+        std::copy_n(&storage[storageOffset(box, slot)], PK3::BOX_LENGTH, out);
+    }
+
+    void Sav3::writeBoxSlot(u8 box, u8 slot, const u8* in)
+    {
+        std::copy_n(in, PK3::BOX_LENGTH, &storage[storageOffset(box, slot)]);
+        syncStorage(storageOffset(box, slot), PK3::BOX_LENGTH);
     }
 
     void Sav3::pkm(const PKX& pk, u8 slot)
@@ -473,22 +547,23 @@ namespace pksm
                 trade(*pk3);
             }
 
-            u32 offset = boxOffset(box, slot);
-            // Is it split?
-            if ((offset % 0x1000) + PK3::BOX_LENGTH > 0xF80)
-            {
-                // Copy into the correct positions if so
-                u32 firstSize = 0xF80 - (offset % 0x1000);
-                std::ranges::copy(pk3->rawData().subspan(0, firstSize), &data[offset]);
-                u32 nextOffset = boxOffset(box + (slot + 1) / 30, (slot + 1) % 30);
-                std::ranges::copy(pk3->rawData().subspan(firstSize, PK3::BOX_LENGTH - firstSize),
-                    &data[nextOffset & 0xFFFFF000]);
-            }
-            else
+            writeBoxSlot(box, slot, pk3->rawData().data());
+
+            markSlot(box, slot, pk.species() != Species::None);
+        }
+    }
+
+    std::vector<Sav::StoredSlot> Sav3::storageTable() const
+    {
+        std::vector<StoredSlot> ret = Sav::storageTable();
+        for (StoredSlot& slot : ret)
+        {
+            if (!slot.where.isParty())
             {
-                std::ranges::copy(pk3->rawData(), &data[offset]);
+                slot.raw = &storage[storageOffset(slot.where.box, slot.where.slot)];
             }
         }
+        return ret;
     }
 
     void Sav3::trade(PKX&, const Date&) const {}
@@ -536,7 +611,7 @@ namespace pksm
         LittleEndian::convertFrom<u32>(&data[PokeDex + 0x8], v);
     }
 
-    void Sav3::dex(const PKX& pk)
+    void Sav3::registerDex(const PKX& pk)
     {
         if (!canSetDex(pk.species()) || pk.egg())
         {
@@ -601,14 +676,14 @@ namespace pksm
 
     int Sav3::dexSeen(void) const
     {
-        return std::count_if(availableSpecies().begin(), availableSpecies().end(),
-            [this](const auto& spec) { return getSeen(spec); });
+        return cachedDexCount(seenCount,
+            [this] { return FlagUtil::countFlags({&data[PokeDex + 0x44]}, u16(maxSpecies())); });
     }
 
     int Sav3::dexCaught(void) const
     {
-        return std::count_if(availableSpecies().begin(), availableSpecies().end(),
-            [this](const auto& spec) { return getCaught(spec); });
+        return cachedDexCount(caughtCount,
+            [this] { return FlagUtil::countFlags({&data[PokeDex + 0x10]}, u16(maxSpecies())); });
     }
 
     // Unused
@@ -619,59 +694,48 @@ namespace pksm
 
     void Sav3::cryptBoxData(bool crypted)
     {
-        for (u8 box = 0; box < maxBoxes(); box++)
-        {
-            for (u8 slot = 0; slot < 30; slot++)
+        executor()->parallelFor(maxBoxes(),
+            [this, crypted](size_t box)
             {
-                u32 offset = boxOffset(box, slot);
-                bool split = (offset % 0x1000) + PK3::BOX_LENGTH > 0xF80;
-                // If it's split, it needs to get fully copied out and re-set in
-                // Otherwise, use the direct-modification constructor
-                std::unique_ptr<PKX> pk3;
-                if (split)
+                for (u8 slot = 0; slot < 30; slot++)
                 {
-                    pk3 = pkm(box, slot);
+                    std::unique_ptr<PKX> pk3 = PKX::getPKM<Generation::THREE>(
+                        &storage[storageOffset(box, slot)], PK3::BOX_LENGTH, true);
+                    if (!crypted)
+                    {
+                        pk3->encrypt();
+                    }
                 }
-                else
-                {
-                    pk3 = PKX::getPKM<Generation::THREE>(&data[offset], PK3::BOX_LENGTH, true);
-                }
-                if (!crypted)
-                {
-                    pk3->encrypt();
-                }
-                if (split)
-                {
-                    pkm(*pk3, box, slot, false);
-                }
-            }
-        }
+                syncStorage(storageOffset(box, 0), PK3::BOX_LENGTH * 30);
+            });
     }
 
     std::string Sav3::boxName(u8 box) const
     {
         return StringUtils::getString3(
-            data.get(), boxOffset(maxBoxes(), 0) + (box * 9), 9, japanese);
+            storage.get(), storageOffset(maxBoxes(), 0) + (box * 9), 9, japanese);
     }
 
     void Sav3::boxName(u8 box, const std::string_view& v)
     {
-        return StringUtils::setString3(
-            data.get(), v, boxOffset(maxBoxes(), 0) + (box * 9), 8, japanese, 9);
+        const u32 offset = storageOffset(maxBoxes(), 0) + (box * 9);
+        StringUtils::setString3(storage.get(), v, offset, 8, japanese, 9);
+        syncStorage(offset, 9);
     }
 
     u8 Sav3::boxWallpaper(u8 box) const
     {
-        int offset = boxOffset(maxBoxes(), 0);
+        int offset = storageOffset(maxBoxes(), 0);
         offset    += (maxBoxes() * 0x9) + box;
-        return data[offset];
+        return storage[offset];
     }
 
     void Sav3::boxWallpaper(u8 box, u8 v)
     {
-        int offset   = boxOffset(maxBoxes(), 0);
-        offset      += (maxBoxes() * 0x9) + box;
-        data[offset] = v;
+        int offset      = storageOffset(maxBoxes(), 0);
+        offset         += (maxBoxes() * 0x9) + box;
+        storage[offset] = v;
+        syncStorage(offset, 1);
     }
 
     u8 Sav3::partyCount(void) const
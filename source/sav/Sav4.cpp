@@ -28,6 +28,8 @@
 #include "pkx/PK4.hpp"
 #include "utils/crypto.hpp"
 #include "utils/endian.hpp"
+#include "utils/executor.hpp"
+#include "utils/flagUtil.hpp"
 #include "utils/i18n.hpp"
 #include "utils/utils.hpp"
 #include "wcx/PGT.hpp"
@@ -122,32 +124,50 @@ namespace pksm
         }
     }
 
-    void Sav4::resign(void)
+    std::array<int, 3> Sav4::generalBlock() const
     {
-        u16 cs;
-        // start, end, chkoffset
-        int general[3] = {0x0,
+        return {0x0,
             game == Game::DP   ? 0xC0EC
             : game == Game::Pt ? 0xCF18
                                : 0xF618,
             game == Game::DP   ? 0xC0FE
             : game == Game::Pt ? 0xCF2A
                                : 0xF626};
-        int storage[3] = {game == Game::DP   ? 0xC100
-                          : game == Game::Pt ? 0xCF2C
-                                             : 0xF700,
+    }
+
+    std::array<int, 3> Sav4::storageBlock() const
+    {
+        return {game == Game::DP   ? 0xC100
+                : game == Game::Pt ? 0xCF2C
+                                   : 0xF700,
             game == Game::DP   ? 0x1E2CC
             : game == Game::Pt ? 0x1F0FC
                                : 0x21A00,
             game == Game::DP   ? 0x1E2DE
             : game == Game::Pt ? 0x1F10E
                                : 0x21A0E};
+    }
 
-        cs = pksm::crypto::ccitt16({&data[gbo + general[0]], (size_t)(general[1] - general[0])});
-        LittleEndian::convertFrom<u16>(&data[gbo + general[2]], cs);
+    std::vector<Sav::SaveBlock> Sav4::saveBlocks() const
+    {
+        auto general = generalBlock();
+        auto storage = storageBlock();
+        return {{0, u32(gbo + general[0]), u32(general[1] - general[0])},
+            {1, u32(sbo + storage[0]), u32(storage[1] - storage[0])}};
+    }
 
-        cs = pksm::crypto::ccitt16({&data[sbo + storage[0]], (size_t)(storage[1] - storage[0])});
-        LittleEndian::convertFrom<u16>(&data[sbo + storage[2]], cs);
+    void Sav4::resign(u8* image) const
+    {
+        u16 cs;
+        // start, end, chkoffset
+        auto general = generalBlock();
+        auto storage = storageBlock();
+
+        cs = pksm::crypto::ccitt16({&image[gbo + general[0]], (size_t)(general[1] - general[0])});
+        LittleEndian::convertFrom<u16>(&image[gbo + general[2]], cs);
+
+        cs = pksm::crypto::ccitt16({&image[sbo + storage[0]], (size_t)(storage[1] - storage[0])});
+        LittleEndian::convertFrom<u16>(&image[sbo + storage[2]], cs);
     }
 
     u16 Sav4::TID(void) const
@@ -333,6 +353,8 @@ namespace pksm
 
             std::ranges::copy(
                 pkm->rawData().subspan(0, PK4::BOX_LENGTH), &data[boxOffset(box, slot)]);
+
+            markSlot(box, slot, pk.species() != Species::None);
         }
     }
 
@@ -349,18 +371,19 @@ namespace pksm
 
     void Sav4::cryptBoxData(bool crypted)
     {
-        for (u8 box = 0; box < maxBoxes(); box++)
-        {
-            for (u8 slot = 0; slot < 30; slot++)
+        executor()->parallelFor(maxBoxes(),
+            [this, crypted](size_t box)
             {
-                std::unique_ptr<PKX> pk4 = PKX::getPKM<Generation::FOUR>(
-                    &data[boxOffset(box, slot)], PK4::BOX_LENGTH, true);
-                if (!crypted)
+                for (u8 slot = 0; slot < 30; slot++)
                 {
-                    pk4->encrypt();
+                    std::unique_ptr<PKX> pk4 = PKX::getPKM<Generation::FOUR>(
+                        &data[boxOffset(box, slot)], PK4::BOX_LENGTH, true);
+                    if (!crypted)
+                    {
+                        pk4->encrypt();
+                    }
                 }
-            }
-        }
+            });
     }
 
     bool Sav4::giftsMenuActivated(void) const
@@ -464,9 +487,9 @@ namespace pksm
         data[Party - 4] = v;
     }
 
-    void Sav4::dex(const PKX& pk)
+    void Sav4::registerDex(const PKX& pk)
     {
-        if (!(availableSpecies().count(pk.species()) > 0) || pk.egg())
+        if (!(speciesTable().count(pk.species()) > 0) || pk.egg())
         {
             return;
         }
@@ -603,43 +626,29 @@ namespace pksm
         data[languageFlags + (game == Game::DP ? dpl : u16(pk.species()))] |= (u8)(1 << lang);
     }
 
-    int Sav4::dexSeen(void) const
+    // Caught flags, then seen flags 0x40 bytes later
+    bool Sav4::getSeen(Species species) const
     {
-        int ret                     = 0;
-        static constexpr int brSize = 0x40;
-        int ofs                     = PokeDex + 0x4;
-        for (const auto& spec : availableSpecies())
-        {
-            u16 i   = u16(spec);
-            int bit = i - 1;
-            int bd  = bit >> 3;
-            int bm  = bit & 7;
+        int bit = u16(species) - 1;
+        return FlagUtil::getFlag(data.get(), PokeDex + 0x4 + 0x40 + (bit >> 3), bit & 7);
+    }
 
-            if ((1 << bm & data[ofs + bd + brSize]) != 0)
-            {
-                ret++;
-            }
-        }
-        return ret;
+    bool Sav4::getCaught(Species species) const
+    {
+        int bit = u16(species) - 1;
+        return FlagUtil::getFlag(data.get(), PokeDex + 0x4 + (bit >> 3), bit & 7);
     }
 
-    int Sav4::dexCaught(void) const
+    int Sav4::dexSeen(void) const
     {
-        int ret = 0;
-        int ofs = PokeDex + 0x4;
-        for (const auto& spec : availableSpecies())
-        {
-            u16 i   = u16(spec);
-            int bit = i - 1;
-            int bd  = bit >> 3;
-            int bm  = bit & 7;
+        return cachedDexCount(seenCount,
+            [this] { return FlagUtil::countFlags({&data[PokeDex + 0x44]}, u16(maxSpecies())); });
+    }
 
-            if ((1 << bm & data[ofs + bd]) != 0)
-            {
-                ret++;
-            }
-        }
-        return ret;
+    int Sav4::dexCaught(void) const
+    {
+        return cachedDexCount(caughtCount,
+            [this] { return FlagUtil::countFlags({&data[PokeDex + 0x4]}, u16(maxSpecies())); });
     }
 
     bool Sav4::checkInsertForm(SmallVector<u8, 0x20>& forms, u8 formNum)
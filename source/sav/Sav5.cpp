@@ -28,6 +28,8 @@
 #include "pkx/PK5.hpp"
 #include "utils/crypto.hpp"
 #include "utils/endian.hpp"
+#include "utils/executor.hpp"
+#include "utils/flagUtil.hpp"
 #include "utils/i18n.hpp"
 #include "utils/utils.hpp"
 #include "wcx/PGF.hpp"
@@ -219,6 +221,8 @@ namespace pksm
 
             std::ranges::copy(
                 pk5->rawData().subspan(0, PK5::BOX_LENGTH), &data[boxOffset(box, slot)]);
+
+            markSlot(box, slot, pk.species() != Species::None);
         }
     }
 
@@ -235,18 +239,19 @@ namespace pksm
 
     void Sav5::cryptBoxData(bool crypted)
     {
-        for (u8 box = 0; box < maxBoxes(); box++)
-        {
-            for (u8 slot = 0; slot < 30; slot++)
+        executor()->parallelFor(maxBoxes(),
+            [this, crypted](size_t box)
             {
-                std::unique_ptr<PKX> pk5 = PKX::getPKM<Generation::FIVE>(
-                    &data[boxOffset(box, slot)], PK5::BOX_LENGTH, true);
-                if (!crypted)
+                for (u8 slot = 0; slot < 30; slot++)
                 {
-                    pk5->encrypt();
+                    std::unique_ptr<PKX> pk5 = PKX::getPKM<Generation::FIVE>(
+                        &data[boxOffset(box, slot)], PK5::BOX_LENGTH, true);
+                    if (!crypted)
+                    {
+                        pk5->encrypt();
+                    }
                 }
-            }
-        }
+            });
     }
 
     int Sav5::dexFormIndex(int species, int formct) const
@@ -312,9 +317,9 @@ namespace pksm
         }
     }
 
-    void Sav5::dex(const PKX& pk)
+    void Sav5::registerDex(const PKX& pk)
     {
-        if (!(availableSpecies().count(pk.species()) > 0) || pk.egg())
+        if (!(speciesTable().count(pk.species()) > 0) || pk.egg())
         {
             return;
         }
@@ -392,40 +397,41 @@ namespace pksm
         data[formDex + formLen * (2 + shiny) + (bit >> 3)] |= (1 << (bit & 7));
     }
 
-    int Sav5::dexSeen(void) const
+    // Seen flags are split by gender and shininess, and any of them counts
+    bool Sav5::getSeen(Species species) const
     {
-        int ret = 0;
-        for (const auto& spec : availableSpecies())
+        int bit = u16(species) - 1;
+        for (int j = 0; j < 4; j++)
         {
-            u16 i        = u16(spec);
-            int bitIndex = (i - 1) & 7;
-            for (int j = 0; j < 4; j++) // All seen flags: gender & shinies
+            if (FlagUtil::getFlag(data.get(), PokeDex + 0x5C + (j * 0x54) + (bit >> 3), bit & 7))
             {
-                int ofs = PokeDex + (0x5C + (j * 0x54)) + ((i - 1) >> 3);
-                if ((data[ofs] >> bitIndex & 1) != 0)
-                {
-                    ret++;
-                    break;
-                }
+                return true;
             }
         }
-        return ret;
+        return false;
     }
 
-    int Sav5::dexCaught(void) const
+    bool Sav5::getCaught(Species species) const
     {
-        int ret = 0;
-        for (const auto& spec : availableSpecies())
-        {
-            u16 i        = u16(spec);
-            int bitIndex = (i - 1) & 7;
-            int ofs      = PokeDex + 0x8 + ((i - 1) >> 3);
-            if ((data[ofs] >> bitIndex & 1) != 0)
+        int bit = u16(species) - 1;
+        return FlagUtil::getFlag(data.get(), PokeDex + 0x8 + (bit >> 3), bit & 7);
+    }
+
+    int Sav5::dexSeen(void) const
+    {
+        return cachedDexCount(seenCount,
+            [this]
             {
-                ret++;
-            }
-        }
-        return ret;
+                const u8* seen = &data[PokeDex + 0x5C];
+                return FlagUtil::countFlags(
+                    {seen, seen + 0x54, seen + 2 * 0x54, seen + 3 * 0x54}, u16(maxSpecies()));
+            });
+    }
+
+    int Sav5::dexCaught(void) const
+    {
+        return cachedDexCount(caughtCount,
+            [this] { return FlagUtil::countFlags({&data[PokeDex + 0x8]}, u16(maxSpecies())); });
     }
 
     void Sav5::mysteryGift(const WCX& wc, int& pos)
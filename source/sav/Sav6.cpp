@@ -27,6 +27,8 @@
 #include "sav/Sav6.hpp"
 #include "pkx/PK6.hpp"
 #include "utils/endian.hpp"
+#include "utils/executor.hpp"
+#include "utils/flagUtil.hpp"
 #include "utils/i18n.hpp"
 #include "utils/random.hpp"
 #include "utils/utils.hpp"
@@ -248,6 +250,8 @@ namespace pksm
 
             std::ranges::copy(
                 pkm->rawData().subspan(0, PK6::BOX_LENGTH), &data[boxOffset(box, slot)]);
+
+            markSlot(box, slot, pk.species() != Species::None);
         }
     }
 
@@ -340,18 +344,19 @@ namespace pksm
 
     void Sav6::cryptBoxData(bool crypted)
     {
-        for (u8 box = 0; box < maxBoxes(); box++)
-        {
-            for (u8 slot = 0; slot < 30; slot++)
+        executor()->parallelFor(maxBoxes(),
+            [this, crypted](size_t box)
             {
-                std::unique_ptr<PKX> pk6 = PKX::getPKM<Generation::SIX>(
-                    &data[boxOffset(box, slot)], PK6::BOX_LENGTH, true);
-                if (!crypted)
+                for (u8 slot = 0; slot < 30; slot++)
                 {
-                    pk6->encrypt();
+                    std::unique_ptr<PKX> pk6 = PKX::getPKM<Generation::SIX>(
+                        &data[boxOffset(box, slot)], PK6::BOX_LENGTH, true);
+                    if (!crypted)
+                    {
+                        pk6->encrypt();
+                    }
                 }
-            }
-        }
+            });
     }
 
     int Sav6::dexFormIndex(int species, int formct) const
@@ -539,9 +544,9 @@ namespace pksm
         }
     }
 
-    void Sav6::dex(const PKX& pk)
+    void Sav6::registerDex(const PKX& pk)
     {
-        if (!(availableSpecies().count(pk.species()) > 0) || pk.egg())
+        if (!(speciesTable().count(pk.species()) > 0) || pk.egg())
         {
             return;
         }
@@ -632,40 +637,41 @@ namespace pksm
         data[formDex + formLen * (2 + shiny) + bit / 8] |= (u8)(1 << (bit % 8));
     }
 
-    int Sav6::dexSeen(void) const
+    // Seen flags are split by gender and shininess, and any of them counts
+    bool Sav6::getSeen(Species species) const
     {
-        int ret = 0;
-        for (const auto& spec : availableSpecies())
+        int bit = u16(species) - 1;
+        for (int j = 0; j < 4; j++)
         {
-            u16 i        = u16(spec);
-            int bitIndex = (i - 1) & 7;
-            for (int j = 0; j < 4; j++) // All seen flags: gender & shinies
+            if (FlagUtil::getFlag(data.get(), PokeDex + 0x68 + (j * 0x60) + (bit >> 3), bit & 7))
             {
-                int ofs = PokeDex + (0x68 + (j * 0x60)) + ((i - 1) >> 3);
-                if ((data[ofs] >> bitIndex & 1) != 0)
-                {
-                    ret++;
-                    break;
-                }
+                return true;
             }
         }
-        return ret;
+        return false;
     }
 
-    int Sav6::dexCaught(void) const
+    bool Sav6::getCaught(Species species) const
     {
-        int ret = 0;
-        for (const auto& spec : availableSpecies())
-        {
-            u16 i        = u16(spec);
-            int bitIndex = (i - 1) & 7;
-            int ofs      = PokeDex + 0x8 + ((i - 1) >> 3);
-            if ((data[ofs] >> bitIndex & 1) != 0)
+        int bit = u16(species) - 1;
+        return FlagUtil::getFlag(data.get(), PokeDex + 0x8 + (bit >> 3), bit & 7);
+    }
+
+    int Sav6::dexSeen(void) const
+    {
+        return cachedDexCount(seenCount,
+            [this]
             {
-                ret++;
-            }
-        }
-        return ret;
+                const u8* seen = &data[PokeDex + 0x68];
+                return FlagUtil::countFlags(
+                    {seen, seen + 0x60, seen + 2 * 0x60, seen + 3 * 0x60}, u16(maxSpecies()));
+            });
+    }
+
+    int Sav6::dexCaught(void) const
+    {
+        return cachedDexCount(caughtCount,
+            [this] { return FlagUtil::countFlags({&data[PokeDex + 0x8]}, u16(maxSpecies())); });
     }
 
     void Sav6::mysteryGift(const WCX& wc, int& pos)
@@ -27,9 +27,12 @@
 #include "sav/Sav7.hpp"
 #include "pkx/PK7.hpp"
 #include "utils/endian.hpp"
+#include "utils/executor.hpp"
+#include "utils/flagUtil.hpp"
 #include "utils/i18n.hpp"
 #include "utils/utils.hpp"
 #include "wcx/WC7.hpp"
+#include <algorithm>
 
 namespace pksm
 {
@@ -248,6 +251,8 @@ namespace pksm
 
             std::ranges::copy(
                 pkm->rawData().subspan(0, PK7::BOX_LENGTH), &data[boxOffset(box, slot)]);
+
+            markSlot(box, slot, pk.species() != Species::None);
         }
     }
 
@@ -286,18 +291,19 @@ namespace pksm
 
     void Sav7::cryptBoxData(bool crypted)
     {
-        for (u8 box = 0; box < maxBoxes(); box++)
-        {
-            for (u8 slot = 0; slot < 30; slot++)
+        executor()->parallelFor(maxBoxes(),
+            [this, crypted](size_t box)
             {
-                std::unique_ptr<PKX> pk7 = PKX::getPKM<Generation::SEVEN>(
-                    &data[boxOffset(box, slot)], PK7::BOX_LENGTH, true);
-                if (!crypted)
+                for (u8 slot = 0; slot < 30; slot++)
                 {
-                    pk7->encrypt();
+                    std::unique_ptr<PKX> pk7 = PKX::getPKM<Generation::SEVEN>(
+                        &data[boxOffset(box, slot)], PK7::BOX_LENGTH, true);
+                    if (!crypted)
+                    {
+                        pk7->encrypt();
+                    }
                 }
-            }
-        }
+            });
     }
 
     void Sav7::setDexFlags(int index, int gender, int shiny, int baseSpecies)
@@ -426,9 +432,9 @@ namespace pksm
         return true;
     }
 
-    void Sav7::dex(const PKX& pk)
+    void Sav7::registerDex(const PKX& pk)
     {
-        if (!(availableSpecies().count(pk.species()) > 0) || pk.egg())
+        if (!(speciesTable().count(pk.species()) > 0) || pk.egg())
         {
             return;
         }
@@ -511,49 +517,51 @@ namespace pksm
         }
     }
 
-    int Sav7::dexSeen(void) const
+    // Seen in any form
+    bool Sav7::getSeen(Species species) const
     {
-        int ret = 0;
-        for (const auto& spec : availableSpecies())
+        int forms = formCount(species);
+        for (int form = 0; form < forms; form++)
         {
-            u16 species = u16(spec);
-            int forms   = formCount(spec);
-            for (int form = 0; form < forms; form++)
-            {
-                int dexForms = form == 0 ? -1
-                                         : dexFormIndex(species, forms,
-                                               u16(VersionTables::maxSpecies(version())) - 1);
+            int dexForms = form == 0 ? -1
+                                     : dexFormIndex(u16(species), forms,
+                                           u16(VersionTables::maxSpecies(version())) - 1);
 
-                int index = species - 1;
-                if (dexForms >= 0)
-                {
-                    index = dexForms + form;
-                }
+            int index = u16(species) - 1;
+            if (dexForms >= 0)
+            {
+                index = dexForms + form;
+            }
 
-                if (getDexFlags(index, species) > 0)
-                {
-                    ret++;
-                    break;
-                }
+            if (getDexFlags(index, u16(species) - 1) > 0)
+            {
+                return true;
             }
         }
-        return ret;
+        return false;
     }
 
-    int Sav7::dexCaught(void) const
+    bool Sav7::getCaught(Species species) const
     {
-        int ret = 0;
-        for (const auto& spec : availableSpecies())
-        {
-            u16 i        = u16(spec);
-            int bitIndex = (i - 1) & 7;
-            int ofs      = PokeDex + 0x88 + ((i - 1) >> 3);
-            if ((data[ofs] >> bitIndex & 1) != 0)
+        int bit = u16(species) - 1;
+        return FlagUtil::getFlag(data.get(), PokeDex + 0x88 + (bit >> 3), bit & 7);
+    }
+
+    int Sav7::dexSeen(void) const
+    {
+        return cachedDexCount(seenCount,
+            [this]
             {
-                ret++;
-            }
-        }
-        return ret;
+                const auto& species = speciesTable();
+                return int(std::count_if(species.begin(), species.end(),
+                    [this](Species s) { return getSeen(s); }));
+            });
+    }
+
+    int Sav7::dexCaught(void) const
+    {
+        return cachedDexCount(caughtCount,
+            [this] { return FlagUtil::countFlags({&data[PokeDex + 0x88]}, u16(maxSpecies())); });
     }
 
     void Sav7::mysteryGift(const WCX& wc, int& pos)
@@ -113,4 +113,47 @@ namespace pksm
         // I could decrypt every block here, but why not just let them be done on the fly via the
         // functions that need them?
     }
+
+    void Sav8::prepareImage()
+    {
+        // The copy has to start from a known state, so every block gets decrypted first
+        beginEditing();
+        decryptBlocks();
+    }
+
+    void Sav8::finishImage(const std::shared_ptr<u8[]>& image) const
+    {
+        for (auto& block : blocks)
+        {
+            block->encryptCopy(image.get());
+        }
+
+        pksm::crypto::swsh::applyXor(image, length);
+        pksm::crypto::swsh::sign(image, length);
+    }
+
+    std::vector<Sav::SaveBlock> Sav8::saveBlocks() const
+    {
+        std::vector<SaveBlock> ret;
+        ret.reserve(blocks.size());
+        for (auto& block : blocks)
+        {
+            // Blocks that haven't been read yet are still encrypted, and would never compare equal
+            // to decrypted ones. Decrypting is safe to do from const members
+            if (!encrypted)
+            {
+                block->decrypt();
+            }
+            ret.push_back({block->key(), u32(block->offset()), u32(block->size())});
+        }
+        return ret;
+    }
+
+    void Sav8::decryptBlocks()
+    {
+        for (auto& block : blocks)
+        {
+            block->decrypt();
+        }
+    }
 }
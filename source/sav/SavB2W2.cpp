@@ -52,15 +52,15 @@ namespace pksm
         Box                  = 0x400;
     }
 
-    void SavB2W2::resign(void)
+    void SavB2W2::resign(u8* image) const
     {
         const u8 blockCount = 74;
 
         for (u8 i = 0; i < blockCount; i++)
         {
-            u16 cs = pksm::crypto::ccitt16({&data[blockOfs[i]], lengths[i]});
-            LittleEndian::convertFrom<u16>(&data[chkMirror[i]], cs);
-            LittleEndian::convertFrom<u16>(&data[chkofs[i]], cs);
+            u16 cs = pksm::crypto::ccitt16({&image[blockOfs[i]], lengths[i]});
+            LittleEndian::convertFrom<u16>(&image[chkMirror[i]], cs);
+            LittleEndian::convertFrom<u16>(&image[chkofs[i]], cs);
         }
 
         // Memories
@@ -72,12 +72,12 @@ namespace pksm
             static constexpr u32 size_to_checksum      = 0x368;
             static constexpr u32 header_size           = 0xC;
             static constexpr u32 crc_offset_from_start = 0x8;
-            // u32 seed = LittleEndian::convertTo<u32>(data.get() + offset + size_to_checksum +
+            // u32 seed = LittleEndian::convertTo<u32>(image + offset + size_to_checksum +
             // header_size - 4);
-            // pksm::crypto::pkm::crypt<size_to_checksum - 4>(data.get() + offset
+            // pksm::crypto::pkm::crypt<size_to_checksum - 4>(image + offset
             // + header_size, seed);
-            u16 crc = pksm::crypto::ccitt16({data.get() + offset + header_size, size_to_checksum});
-            LittleEndian::convertFrom<u16>(data.get() + offset + crc_offset_from_start, crc);
+            u16 crc = pksm::crypto::ccitt16({image + offset + header_size, size_to_checksum});
+            LittleEndian::convertFrom<u16>(image + offset + crc_offset_from_start, crc);
         }
         // Block 1 mirror
         {
@@ -85,12 +85,12 @@ namespace pksm
             static constexpr u32 size_to_checksum      = 0x368;
             static constexpr u32 header_size           = 0xC;
             static constexpr u32 crc_offset_from_start = 0x8;
-            // u32 seed = LittleEndian::convertTo<u32>(data.get() + offset + size_to_checksum +
+            // u32 seed = LittleEndian::convertTo<u32>(image + offset + size_to_checksum +
             // header_size - 4);
-            // pksm::crypto::pkm::crypt<size_to_checksum - 4>(data.get() + offset
+            // pksm::crypto::pkm::crypt<size_to_checksum - 4>(image + offset
             // + header_size, seed);
-            u16 crc = pksm::crypto::ccitt16({data.get() + offset + header_size, size_to_checksum});
-            LittleEndian::convertFrom<u16>(data.get() + offset + crc_offset_from_start, crc);
+            u16 crc = pksm::crypto::ccitt16({image + offset + header_size, size_to_checksum});
+            LittleEndian::convertFrom<u16>(image + offset + crc_offset_from_start, crc);
         }
         // Block 2
         {
@@ -98,8 +98,8 @@ namespace pksm
             static constexpr u32 size_to_checksum      = 0x214;
             static constexpr u32 header_size           = 0xC;
             static constexpr u32 crc_offset_from_start = 0x8;
-            u16 crc = pksm::crypto::ccitt16({data.get() + offset + header_size, size_to_checksum});
-            LittleEndian::convertFrom<u16>(data.get() + offset + crc_offset_from_start, crc);
+            u16 crc = pksm::crypto::ccitt16({image + offset + header_size, size_to_checksum});
+            LittleEndian::convertFrom<u16>(image + offset + crc_offset_from_start, crc);
         }
     }
 
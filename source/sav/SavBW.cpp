@@ -52,15 +52,15 @@ namespace pksm
         Box                  = 0x400;
     }
 
-    void SavBW::resign(void)
+    void SavBW::resign(u8* image) const
     {
         const u8 blockCount = 70;
 
         for (u8 i = 0; i < blockCount; i++)
         {
-            u16 cs = pksm::crypto::ccitt16({&data[blockOfs[i]], lengths[i]});
-            LittleEndian::convertFrom<u16>(&data[chkMirror[i]], cs);
-            LittleEndian::convertFrom<u16>(&data[chkofs[i]], cs);
+            u16 cs = pksm::crypto::ccitt16({&image[blockOfs[i]], lengths[i]});
+            LittleEndian::convertFrom<u16>(&image[chkMirror[i]], cs);
+            LittleEndian::convertFrom<u16>(&image[chkofs[i]], cs);
         }
     }
 
@@ -28,12 +28,15 @@
 #include "pkx/PB7.hpp"
 #include "utils/crypto.hpp"
 #include "utils/endian.hpp"
+#include "utils/executor.hpp"
+#include "utils/flagUtil.hpp"
 #include "utils/i18n.hpp"
 #include "utils/random.hpp"
 #include "utils/utils.hpp"
 #include "wcx/WB7.hpp"
 #include <algorithm>
 #include <bit>
+#include <numeric>
 
 namespace
 {
@@ -130,51 +133,38 @@ namespace pksm
 
     void SavLGPE::compressBox()
     {
-        u16 emptyIndex                  = 1001;
-        u8 emptyData[PB7::PARTY_LENGTH] = {0};
-        for (u16 i = 0; i < 1000; i++)
-        {
-            u32 offset = boxOffset(i / 30, i % 30);
-            if (emptyIndex == 1001 && !isPKM(&data[offset]))
-            {
-                emptyIndex = i;
-            }
-            else if (emptyIndex != 1001)
+        compactSlots(
+            1000, [this](int i) { return isPKM(&data[boxOffset(i / 30, i % 30)]); },
+            [this](int empty, int full)
             {
-                if (isPKM(&data[offset]))
+                u32 emptyOffset = boxOffset(empty / 30, empty % 30);
+                u32 offset      = boxOffset(full / 30, full % 30);
+                std::swap_ranges(
+                    &data[offset], &data[offset + PB7::PARTY_LENGTH], &data[emptyOffset]);
+                for (int j = 0; j < 6; j++)
                 {
-                    u32 emptyOffset = boxOffset(emptyIndex / 30, emptyIndex % 30);
-                    // Swap the two slots
-                    std::copy(
-                        &data[emptyOffset], &data[emptyOffset + PB7::PARTY_LENGTH], emptyData);
-                    std::copy(&data[offset], &data[offset + PB7::PARTY_LENGTH], &data[emptyOffset]);
-                    std::copy(emptyData, emptyData + PB7::PARTY_LENGTH, &data[offset]);
-                    for (int j = 0; j < partyCount(); j++)
-                    {
-                        if (partyBoxSlot(j) == i)
-                        {
-                            partyBoxSlot(j, emptyIndex);
-                        }
-                    }
-                    if (followPkm() == i)
+                    if (partyBoxSlot(j) == full)
                     {
-                        followPkm(emptyIndex);
+                        partyBoxSlot(j, empty);
                     }
-                    emptyIndex++;
                 }
-            }
-        }
+                if (followPkm() == full)
+                {
+                    followPkm(empty);
+                }
+            });
+        invalidateFreeSlots();
     }
 
-    void SavLGPE::resign()
+    void SavLGPE::resign(u8* image) const
     {
         const u8 blockCount = 21;
         const u32 csoff     = 0xB861A;
 
         for (u8 i = 0; i < blockCount; i++)
         {
-            LittleEndian::convertFrom<u16>(
-                &data[csoff + i * 8], pksm::crypto::crc16_noinvert({&data[chkofs[i]], chklen[i]}));
+            LittleEndian::convertFrom<u16>(&image[csoff + i * 8],
+                pksm::crypto::crc16_noinvert({&image[chkofs[i]], chklen[i]}));
         }
     }
 
@@ -327,6 +317,8 @@ namespace pksm
 
             std::ranges::copy(
                 pb7->rawData().subspan(0, PB7::PARTY_LENGTH), &data[boxOffset(box, slot)]);
+
+            markSlot(box, slot, pk.species() != Species::None);
         }
     }
 
@@ -341,6 +333,7 @@ namespace pksm
                 if (off != 0)
                 {
                     std::fill_n(&data[off], PB7::PARTY_LENGTH, 0);
+                    markSlot(newSlot / 30, newSlot % 30, false);
                 }
                 partyBoxSlot(slot, 1001);
                 return;
@@ -365,6 +358,7 @@ namespace pksm
             auto pb7 = pk.partyClone();
             std::ranges::copy(pb7->rawData().subspan(0, PB7::PARTY_LENGTH), &data[off]);
             partyBoxSlot(slot, newSlot);
+            markSlot(newSlot / 30, newSlot % 30, true);
         }
     }
 
@@ -512,14 +506,14 @@ namespace pksm
         return ret;
     }
 
-    void SavLGPE::dex(const PKX& pk)
+    void SavLGPE::registerDex(const PKX& pk)
     {
         int n                    = u16(pk.species());
         int MaxSpeciesID         = 809;
         int PokeDex              = 0x2A00;
         int PokeDexLanguageFlags = PokeDex + 0x550;
 
-        if (!(availableSpecies().count(pk.species()) > 0) || pk.egg())
+        if (!(speciesTable().count(pk.species()) > 0) || pk.egg())
         {
             return;
         }
@@ -601,65 +595,114 @@ namespace pksm
         }
     }
 
-    int SavLGPE::dexSeen(void) const
+    // Seen in any form
+    bool SavLGPE::getSeen(Species species) const
     {
-        int ret = 0;
-        for (const auto& species : availableSpecies())
+        int forms = formCount(species);
+        for (int form = 0; form < forms; form++)
         {
-            int forms = formCount(species);
-            for (int form = 0; form < forms; form++)
-            {
-                int dexForms = form == 0 ? -1
-                                         : dexFormIndex(u16(species), forms,
-                                               u16(VersionTables::maxSpecies(version())) - 1);
+            int dexForms = form == 0 ? -1
+                                     : dexFormIndex(u16(species), forms,
+                                           u16(VersionTables::maxSpecies(version())) - 1);
 
-                int index = u16(species) - 1;
-                if (dexForms >= 0)
-                {
-                    index = dexForms + form;
-                }
+            int index = u16(species) - 1;
+            if (dexForms >= 0)
+            {
+                index = dexForms + form;
+            }
 
-                if (getDexFlags(index, u16(species)) > 0)
-                {
-                    ret++;
-                    break;
-                }
+            if (getDexFlags(index, u16(species) - 1) > 0)
+            {
+                return true;
             }
         }
-        return ret;
+        return false;
+    }
+
+    bool SavLGPE::getCaught(Species species) const
+    {
+        int bit = u16(species) - 1;
+        return FlagUtil::getFlag(data.get(), PokeDex + 0x88 + (bit >> 3), bit & 7);
+    }
+
+    int SavLGPE::dexSeen(void) const
+    {
+        return cachedDexCount(seenCount,
+            [this]
+            {
+                const auto& species = speciesTable();
+                return int(std::count_if(species.begin(), species.end(),
+                    [this](Species s) { return getSeen(s); }));
+            });
     }
 
     int SavLGPE::dexCaught(void) const
     {
-        int ret = 0;
-        for (const auto& species : availableSpecies())
+        // Only Meltan and Melmetal follow the 151 Kanto species
+        return cachedDexCount(caughtCount,
+            [this]
+            {
+                return FlagUtil::countFlags({&data[PokeDex + 0x88]}, 151) +
+                       int(getCaught(Species::Meltan)) + int(getCaught(Species::Melmetal));
+            });
+    }
+
+    std::vector<Sav::StoredSlot> SavLGPE::storageTable() const
+    {
+        // The party is just a list of box slots, so only the boxes are stored
+        std::vector<StoredSlot> ret;
+        ret.reserve(maxSlot());
+        for (int i = 0; i < maxSlot(); i++)
+        {
+            ret.push_back(
+                {{u8(i / 30), u8(i % 30)}, &data[boxOffset(i / 30, i % 30)], PB7::PARTY_LENGTH});
+        }
+        return ret;
+    }
+
+    // The party and the following Pokemon are box indices, so they have to move with the boxes
+    void SavLGPE::boxSlotsMoved(
+        const std::vector<StorageSlot>& slots, const std::vector<size_t>& order)
+    {
+        std::vector<u16> newIndex(maxSlot());
+        std::iota(newIndex.begin(), newIndex.end(), 0);
+        for (size_t i = 0; i < slots.size(); i++)
+        {
+            const StorageSlot& from             = slots[order[i]];
+            newIndex[from.box * 30 + from.slot] = slots[i].box * 30 + slots[i].slot;
+        }
+        for (u8 i = 0; i < 6; i++)
         {
-            if (data[PokeDex + 0x88 + (u16(species) - 1) / 8] & (1 << ((u16(species) - 1) % 8)))
+            if (partyBoxSlot(i) < maxSlot())
             {
-                ret++;
+                partyBoxSlot(i, newIndex[partyBoxSlot(i)]);
             }
         }
-        return ret;
+        if (followPkm() < maxSlot())
+        {
+            followPkm(newIndex[followPkm()]);
+        }
     }
 
     void SavLGPE::cryptBoxData(bool crypted)
     {
-        for (u8 box = 0; box < maxBoxes(); box++)
-        {
-            for (u8 slot = 0; slot < 30; slot++)
+        executor()->parallelFor(maxBoxes(),
+            [this, crypted](size_t box)
             {
-                if (box * 30 + slot > 1000)
-                {
-                    return;
-                }
-                std::unique_ptr<PKX> pb7 = PKX::getPKM<Generation::LGPE>(
-                    &data[boxOffset(box, slot)], PB7::PARTY_LENGTH, true);
-                if (!crypted)
+                for (u8 slot = 0; slot < 30; slot++)
                 {
-                    pb7->encrypt();
+                    if (box * 30 + slot > 1000)
+                    {
+                        return;
+                    }
+                    std::unique_ptr<PKX> pb7 = PKX::getPKM<Generation::LGPE>(
+                        &data[boxOffset(box, slot)], PB7::PARTY_LENGTH, true);
+                    if (!crypted)
+                    {
+                        pb7->encrypt();
+                    }
                 }
-            }
-        }
+            });
     }
 
     void SavLGPE::mysteryGift(const WCX& wc, int&)
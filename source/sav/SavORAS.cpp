@@ -54,7 +54,7 @@ namespace pksm
         PouchBerry           = 0xE70;
     }
 
-    void SavORAS::resign(void)
+    void SavORAS::resign(u8* image) const
     {
         static constexpr u8 blockCount = 58;
         static constexpr u32 csoff     = 0x75E1A;
@@ -62,7 +62,7 @@ namespace pksm
         for (u8 i = 0; i < blockCount; i++)
         {
             LittleEndian::convertFrom<u16>(
-                &data[csoff + i * 8], pksm::crypto::ccitt16({&data[chkofs[i]], chklen[i]}));
+                &image[csoff + i * 8], pksm::crypto::ccitt16({&image[chkofs[i]], chklen[i]}));
         }
     }
 
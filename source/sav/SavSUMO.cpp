@@ -55,7 +55,7 @@ namespace pksm
         PouchZCrystals       = 0xD68;
     }
 
-    void SavSUMO::resign(void)
+    void SavSUMO::resign(u8* image) const
     {
         static constexpr u8 blockCount = 37;
         static constexpr u32 csoff     = 0x6BC1A;
@@ -63,25 +63,25 @@ namespace pksm
         for (u8 i = 0; i < blockCount; i++)
         {
             // Clear memecrypto data
-            if (LittleEndian::convertTo<u16>(&data[csoff + i * 8 - 2]) == 36)
+            if (LittleEndian::convertTo<u16>(&image[csoff + i * 8 - 2]) == 36)
             {
-                std::fill_n(&data[chkofs[i] + 0x100], 0x80, 0);
+                std::fill_n(&image[chkofs[i] + 0x100], 0x80, 0);
             }
             LittleEndian::convertFrom<u16>(
-                &data[csoff + i * 8], pksm::crypto::crc16({&data[chkofs[i]], chklen[i]}));
+                &image[csoff + i * 8], pksm::crypto::crc16({&image[chkofs[i]], chklen[i]}));
         }
 
         static constexpr u32 checksumTableOffset = 0x6BC00;
         static constexpr u32 checksumTableLength = 0x140;
         static constexpr u32 memecryptoOffset    = 0x6BB00;
 
-        auto hash = crypto::sha256({&data[checksumTableOffset], checksumTableLength});
+        auto hash = crypto::sha256({&image[checksumTableOffset], checksumTableLength});
 
         u8 decryptedSignature[0x80];
-        reverseCrypt(&data[memecryptoOffset], decryptedSignature);
+        reverseCrypt(&image[memecryptoOffset], decryptedSignature);
         std::copy(hash.begin(), hash.end(), decryptedSignature);
 
-        memecrypto_sign(decryptedSignature, &data[memecryptoOffset], 0x80);
+        memecrypto_sign(decryptedSignature, &image[memecryptoOffset], 0x80);
     }
 
     int SavSUMO::dexFormIndex(int species, int formct, int start) const
@@ -27,6 +27,8 @@
 #include "sav/SavSWSH.hpp"
 #include "pkx/PK8.hpp"
 #include "utils/endian.hpp"
+#include "utils/executor.hpp"
+#include "utils/flagUtil.hpp"
 #include "utils/i18n.hpp"
 #include "utils/random.hpp"
 #include "utils/utils.hpp"
@@ -594,6 +596,8 @@ namespace pksm
 
             std::ranges::copy(
                 pk8->rawData(), getBlock(Box)->decryptedData() + boxOffset(box, slot));
+
+            markSlot(box, slot, pk.species() != Species::None);
         }
     }
 
@@ -607,20 +611,60 @@ namespace pksm
         }
     }
 
-    void SavSWSH::cryptBoxData(bool crypted)
+    std::vector<Sav::StoredSlot> SavSWSH::storageTable() const
     {
-        for (u8 box = 0; box < maxBoxes(); box++)
+        u8* party = getBlock(Party)->decryptedData();
+        u8* box   = getBlock(Box)->decryptedData();
+
+        std::vector<StoredSlot> ret;
+        ret.reserve(6 + maxSlot());
+        for (u8 slot = 0; slot < std::min(partyCount(), u8(6)); slot++)
+        {
+            ret.push_back(
+                {{StorageSlot::PARTY, slot}, party + partyOffset(slot), PK8::PARTY_LENGTH});
+        }
+        for (int i = 0; i < maxSlot(); i++)
         {
-            for (u8 slot = 0; slot < 30; slot++)
+            ret.push_back(
+                {{u8(i / 30), u8(i % 30)}, box + boxOffset(i / 30, i % 30), PK8::PARTY_LENGTH});
+        }
+        return ret;
+    }
+
+    void SavSWSH::swapPartySlots(u8 a, u8 b)
+    {
+        u8* party = getBlock(Party)->decryptedData();
+        std::swap_ranges(party + partyOffset(a), party + partyOffset(a) + PK8::PARTY_LENGTH,
+            party + partyOffset(b));
+    }
+
+    void SavSWSH::readBoxSlot(u8 box, u8 slot, u8* out) const
+    {
+        std::copy_n(
+            getBlock(Box)->decryptedData() + boxOffset(box, slot), PK8::PARTY_LENGTH, out);
+    }
+
+    void SavSWSH::writeBoxSlot(u8 box, u8 slot, const u8* in)
+    {
+        std::copy_n(in, PK8::PARTY_LENGTH, getBlock(Box)->decryptedData() + boxOffset(box, slot));
+    }
+
+    void SavSWSH::cryptBoxData(bool crypted)
+    {
+        u8* boxData = getBlock(Box)->decryptedData();
+        executor()->parallelFor(maxBoxes(),
+            [this, crypted, boxData](size_t box)
             {
-                std::unique_ptr<PKX> pk8 = PKX::getPKM<Generation::EIGHT>(
-                    getBlock(Box)->decryptedData() + boxOffset(box, slot), PK8::PARTY_LENGTH, true);
-                if (!crypted)
+                for (u8 slot = 0; slot < 30; slot++)
                 {
-                    pk8->encrypt();
+                    std::unique_ptr<PKX> pk8 = PKX::getPKM<Generation::EIGHT>(
+                        boxData + boxOffset(box, slot), PK8::PARTY_LENGTH, true);
+                    if (!crypted)
+                    {
+                        pk8->encrypt();
+                    }
                 }
-            }
-        }
+            });
     }
 
     void SavSWSH::mysteryGift(const WCX& wc, int&)
@@ -630,17 +674,10 @@ namespace pksm
             const WC8& wc8 = static_cast<const WC8&>(wc);
             if (wc8.pokemon())
             {
-                int injectPosition = 0;
-                for (injectPosition = 0; injectPosition < maxSlot(); injectPosition++)
-                {
-                    if (pkm(injectPosition / 30, injectPosition % 30)->species() == Species::None)
-                    {
-                        break;
-                    }
-                }
+                int injectPosition = firstFreeSlot();
 
                 // No place to put generated PK8!
-                if (injectPosition == maxSlot())
+                if (injectPosition == -1)
                 {
                     return;
                 }
@@ -912,7 +949,17 @@ namespace pksm
         return nullptr;
     }
 
-    void SavSWSH::dex(const PKX& pk)
+    std::pair<u64, u32> SavSWSH::dexKey(const PKX& pk) const
+    {
+        std::pair<u64, u32> ret = Sav::dexKey(pk);
+        if (pk.species() == Species::Alcremie)
+        {
+            ret.second = static_cast<const PK8&>(pk).formDuration();
+        }
+        return ret;
+    }
+
+    void SavSWSH::registerDex(const PKX& pk)
     {
         u8* entryAddr = nullptr;
         if (!pk.egg())
@@ -962,37 +1009,54 @@ namespace pksm
         }
     }
 
-    int SavSWSH::dexSeen() const
+    const u8* SavSWSH::dexEntry(Species species) const
     {
-        int ret = 0;
-        for (const auto& i : availableSpecies())
+        if (u16 index = PersonalSWSH::pokedexIndex(u16(species)))
         {
-            u16 index       = PersonalSWSH::pokedexIndex(u16(i));
-            u8* entryOffset = getBlock(PokeDex)->decryptedData() + index * sizeof(DexEntry);
-            for (size_t j = 0; j < 0x20; j++) // Entire seen region size
-            {
-                if (entryOffset[j])
-                {
-                    ret++;
-                    break;
-                }
-            }
+            return getBlock(PokeDex)->decryptedData() + sizeof(DexEntry) * (index - 1);
         }
-        return ret;
+        else if (u16 index = PersonalSWSH::armordexIndex(u16(species)))
+        {
+            return getBlock(ArmorDex)->decryptedData() + sizeof(DexEntry) * (index - 1);
+        }
+        else if (u16 index = PersonalSWSH::crowndexIndex(u16(species)))
+        {
+            return getBlock(CrownDex)->decryptedData() + sizeof(DexEntry) * (index - 1);
+        }
+        return nullptr;
+    }
+
+    bool SavSWSH::getSeen(Species species) const
+    {
+        const u8* entry = dexEntry(species);
+        return entry && std::any_of(entry, entry + 0x20, [](u8 b) { return b != 0; });
+    }
+
+    bool SavSWSH::getCaught(Species species) const
+    {
+        const u8* entry = dexEntry(species);
+        return entry && (entry[0x20] & 3) != 0;
+    }
+
+    int SavSWSH::dexSeen() const
+    {
+        return cachedDexCount(seenCount,
+            [this]
+            {
+                const auto& species = speciesTable();
+                return int(std::count_if(species.begin(), species.end(),
+                    [this](Species s) { return getSeen(s); }));
+            });
     }
 
     int SavSWSH::dexCaught() const
     {
-        int ret = 0;
-        for (const auto& i : availableSpecies())
-        {
-            u16 index       = PersonalSWSH::pokedexIndex(u16(i));
-            u8* entryOffset = getBlock(PokeDex)->decryptedData() + index * sizeof(DexEntry);
-            if (entryOffset[0x20] & 3)
+        return cachedDexCount(caughtCount,
+            [this]
             {
-                ret++;
-            }
-        }
-        return ret;
+                const auto& species = speciesTable();
+                return int(std::count_if(species.begin(), species.end(),
+                    [this](Species s) { return getCaught(s); }));
+            });
     }
 }
@@ -56,7 +56,7 @@ namespace pksm
         BattleItems          = 0xDFC;
     }
 
-    void SavUSUM::resign(void)
+    void SavUSUM::resign(u8* image) const
     {
         static constexpr u8 blockCount = 39;
         static constexpr u32 csoff     = 0x6CA1A;
@@ -64,25 +64,25 @@ namespace pksm
         for (u8 i = 0; i < blockCount; i++)
         {
             // Clear memecrypto data
-            if (LittleEndian::convertTo<u16>(&data[csoff + i * 8 - 2]) == 36)
+            if (LittleEndian::convertTo<u16>(&image[csoff + i * 8 - 2]) == 36)
             {
-                std::fill_n(&data[chkofs[i] + 0x100], 0x80, 0);
+                std::fill_n(&image[chkofs[i] + 0x100], 0x80, 0);
             }
             LittleEndian::convertFrom<u16>(
-                &data[csoff + i * 8], pksm::crypto::crc16({&data[chkofs[i]], chklen[i]}));
+                &image[csoff + i * 8], pksm::crypto::crc16({&image[chkofs[i]], chklen[i]}));
         }
 
         const u32 checksumTableOffset = 0x6CA00;
         const u32 checksumTableLength = 0x150;
         const u32 memecryptoOffset    = 0x6C100;
 
-        auto hash = crypto::sha256({&data[checksumTableOffset], checksumTableLength});
+        auto hash = crypto::sha256({&image[checksumTableOffset], checksumTableLength});
 
         u8 decryptedSignature[0x80];
-        reverseCrypt(&data[memecryptoOffset], decryptedSignature);
+        reverseCrypt(&image[memecryptoOffset], decryptedSignature);
         std::copy(hash.begin(), hash.end(), decryptedSignature);
 
-        memecrypto_sign(decryptedSignature, &data[memecryptoOffset], 0x80);
+        memecrypto_sign(decryptedSignature, &image[memecryptoOffset], 0x80);
     }
 
     int SavUSUM::dexFormIndex(int species, int formct, int start) const
@@ -0,0 +1,408 @@
+/*
+ *   This file is part of PKSM-Core
+ *   Copyright (C) 2016-2022 Bernardo Giordano, Admiral Fish, piepie62
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+ *       * Requiring preservation of specified reasonable legal notices or
+ *         author attributions in that material or in the Appropriate Legal
+ *         Notices displayed by works containing it.
+ *       * Prohibiting misrepresentation of the origin of that material,
+ *         or requiring that modified versions of such material be marked in
+ *         reasonable ways as different from the original version.
+ */
+
+#include "sav/SearchIndex.hpp"
+#include "pkx/PK8.hpp"
+#include "utils/endian.hpp"
+#include "utils/io.hpp"
+#include <algorithm>
+#include <cstdio>
+
+namespace
+{
+    enum class Field : u8
+    {
+        Species,
+        Shiny,
+        Gigantamax,
+        Ball,
+        Trainer,
+        EncryptionConstant,
+        PID
+    };
+
+    constexpr u32 MAGIC   = 0x49534B50; // PKSI
+    constexpr u32 VERSION = 1;
+    // Magic, version, key count, posting count
+    constexpr size_t HEADER_LENGTH = 16;
+    // Key, first posting, posting count
+    constexpr size_t ENTRY_LENGTH  = 16;
+
+    pksm::SearchIndex::Key makeKey(Field field, u32 value)
+    {
+        return {u64(field) << 56 | value};
+    }
+
+    u64 saveStart(u32 save)
+    {
+        return u64(save) << 16;
+    }
+
+    // Drops the candidates not found in a sorted list of size postings, read through at
+    template <typename At>
+    void retainIn(std::vector<u64>& candidates, size_t size, At&& at)
+    {
+        std::erase_if(candidates,
+            [&](u64 candidate)
+            {
+                size_t low = 0, high = size;
+                while (low < high)
+                {
+                    size_t mid = low + (high - low) / 2;
+                    if (at(mid) < candidate)
+                    {
+                        low = mid + 1;
+                    }
+                    else
+                    {
+                        high = mid;
+                    }
+                }
+                return low == size || at(low) != candidate;
+            });
+    }
+
+    std::vector<pksm::SearchIndex::Result> toResults(const std::vector<u64>& postings)
+    {
+        std::vector<pksm::SearchIndex::Result> ret;
+        ret.reserve(postings.size());
+        for (u64 posting : postings)
+        {
+            ret.push_back({u32(posting >> 16), {u8(posting >> 8), u8(posting)}});
+        }
+        return ret;
+    }
+}
+
+namespace pksm
+{
+    SearchIndex::Key SearchIndex::Key::species(Species species, u16 form)
+    {
+        return makeKey(Field::Species, u32(u16(species)) << 16 | form);
+    }
+
+    SearchIndex::Key SearchIndex::Key::shiny()
+    {
+        return makeKey(Field::Shiny, 0);
+    }
+
+    SearchIndex::Key SearchIndex::Key::gigantamax()
+    {
+        return makeKey(Field::Gigantamax, 0);
+    }
+
+    SearchIndex::Key SearchIndex::Key::ball(Ball ball)
+    {
+        return makeKey(Field::Ball, u8(ball));
+    }
+
+    SearchIndex::Key SearchIndex::Key::trainer(u16 TID, u16 SID)
+    {
+        return makeKey(Field::Trainer, u32(TID) << 16 | SID);
+    }
+
+    SearchIndex::Key SearchIndex::Key::encryptionConstant(u32 ec)
+    {
+        return makeKey(Field::EncryptionConstant, ec);
+    }
+
+    SearchIndex::Key SearchIndex::Key::PID(u32 pid)
+    {
+        return makeKey(Field::PID, pid);
+    }
+
+    void SearchIndex::update(u32 save, const Sav& sav)
+    {
+        remove(save);
+
+        std::map<Key, std::vector<u64>> added;
+        sav.forEachPKM(
+            [&](const PKX& pk, Sav::StorageSlot where)
+            {
+                const u64 posting = saveStart(save) | u64(where.box) << 8 | where.slot;
+                auto add          = [&](Key key) { added[key].push_back(posting); };
+
+                add(Key::species(pk.species(), pk.alternativeForm()));
+                add(Key::ball(pk.ball()));
+                add(Key::trainer(pk.TID(), pk.SID()));
+                if (pk.shiny())
+                {
+                    add(Key::shiny());
+                }
+                if (pk.generation() == Generation::EIGHT && static_cast<const PK8&>(pk).canGiga())
+                {
+                    add(Key::gigantamax());
+                }
+                // Gen I and II have neither, and every Pokemon would share one list
+                if (pk.generation() >= Generation::THREE)
+                {
+                    add(Key::encryptionConstant(pk.encryptionConstant()));
+                    add(Key::PID(pk.PID()));
+                }
+            });
+
+        if (added.empty())
+        {
+            return;
+        }
+        std::vector<Key>& keys = saveKeys[save];
+        keys.reserve(added.size());
+        for (auto& [key, list] : added)
+        {
+            // Party slots come first in storage order but sort after the boxes
+            std::sort(list.begin(), list.end());
+            std::vector<u64>& target = postings[key];
+            target.insert(std::lower_bound(target.begin(), target.end(), saveStart(save)),
+                list.begin(), list.end());
+            keys.push_back(key);
+        }
+    }
+
+    void SearchIndex::remove(u32 save)
+    {
+        auto found = saveKeys.find(save);
+        if (found == saveKeys.end())
+        {
+            return;
+        }
+        for (const Key& key : found->second)
+        {
+            auto list = postings.find(key);
+            if (list == postings.end())
+            {
+                continue;
+            }
+            std::vector<u64>& values = list->second;
+            values.erase(std::lower_bound(values.begin(), values.end(), saveStart(save)),
+                std::lower_bound(values.begin(), values.end(), saveStart(save) + 0x10000));
+            if (values.empty())
+            {
+                postings.erase(list);
+            }
+        }
+        saveKeys.erase(found);
+    }
+
+    std::vector<SearchIndex::Result> SearchIndex::query(const std::vector<Key>& keys) const
+    {
+        std::vector<const std::vector<u64>*> lists;
+        for (const Key& key : keys)
+        {
+            auto found = postings.find(key);
+            if (found == postings.end())
+            {
+                return {};
+            }
+            lists.push_back(&found->second);
+        }
+        if (lists.empty())
+        {
+            return {};
+        }
+
+        // Starting from the shortest list keeps the candidate set as small as it can be
+        std::sort(lists.begin(), lists.end(),
+            [](const std::vector<u64>* a, const std::vector<u64>* b)
+            { return a->size() < b->size(); });
+        std::vector<u64> candidates = *lists[0];
+        for (size_t i = 1; i < lists.size() && !candidates.empty(); i++)
+        {
+            retainIn(candidates, lists[i]->size(), [&](size_t j) { return (*lists[i])[j]; });
+        }
+        return toResults(candidates);
+    }
+
+    std::vector<u8> SearchIndex::serialize() const
+    {
+        size_t postingCount = 0;
+        for (const auto& [key, list] : postings)
+        {
+            postingCount += list.size();
+        }
+
+        std::vector<u8> ret(HEADER_LENGTH + ENTRY_LENGTH * postings.size() + 8 * postingCount);
+        LittleEndian::convertFrom<u32>(&ret[0x0], MAGIC);
+        LittleEndian::convertFrom<u32>(&ret[0x4], VERSION);
+        LittleEndian::convertFrom<u32>(&ret[0x8], postings.size());
+        LittleEndian::convertFrom<u32>(&ret[0xC], postingCount);
+
+        u8* entry   = &ret[HEADER_LENGTH];
+        u8* posting = entry + ENTRY_LENGTH * postings.size();
+        u32 first   = 0;
+        for (const auto& [key, list] : postings)
+        {
+            LittleEndian::convertFrom<u64>(entry, key.value);
+            LittleEndian::convertFrom<u32>(entry + 0x8, first);
+            LittleEndian::convertFrom<u32>(entry + 0xC, list.size());
+            entry += ENTRY_LENGTH;
+            for (u64 value : list)
+            {
+                LittleEndian::convertFrom<u64>(posting, value);
+                posting += 8;
+            }
+            first += list.size();
+        }
+        return ret;
+    }
+
+    bool SearchIndex::write(const std::string& path) const
+    {
+        const std::vector<u8> data = serialize();
+        FILE* out                  = fopen(path.c_str(), "wb");
+        if (!out)
+        {
+            return false;
+        }
+        bool ok = fwrite(data.data(), 1, data.size(), out) == data.size();
+        return fclose(out) == 0 && ok;
+    }
+
+    SearchIndex::SearchIndex(const View& view)
+    {
+        for (size_t i = 0; i < view.keyCount; i++)
+        {
+            const u8* entry = &view.data[HEADER_LENGTH + ENTRY_LENGTH * i];
+            Key key{LittleEndian::convertTo<u64>(entry)};
+            u32 first = LittleEndian::convertTo<u32>(entry + 0x8);
+            u32 count = LittleEndian::convertTo<u32>(entry + 0xC);
+
+            std::vector<u64>& list = postings[key];
+            list.reserve(count);
+            for (u32 j = first; j < first + count; j++)
+            {
+                list.push_back(view.posting(j));
+                std::vector<Key>& keys = saveKeys[u32(list.back() >> 16)];
+                if (keys.empty() || keys.back() != key)
+                {
+                    keys.push_back(key);
+                }
+            }
+        }
+    }
+
+    SearchIndex::View::View(std::shared_ptr<const u8[]> data, size_t length)
+    {
+        if (!data || length < HEADER_LENGTH ||
+            LittleEndian::convertTo<u32>(&data[0x0]) != MAGIC ||
+            LittleEndian::convertTo<u32>(&data[0x4]) != VERSION)
+        {
+            return;
+        }
+        size_t keys     = LittleEndian::convertTo<u32>(&data[0x8]);
+        size_t postings = LittleEndian::convertTo<u32>(&data[0xC]);
+        if (length < HEADER_LENGTH + ENTRY_LENGTH * keys + 8 * postings)
+        {
+            return;
+        }
+        for (size_t i = 0; i < keys; i++)
+        {
+            const u8* entry = &data[HEADER_LENGTH + ENTRY_LENGTH * i];
+            if (u64(LittleEndian::convertTo<u32>(entry + 0x8)) +
+                    LittleEndian::convertTo<u32>(entry + 0xC) >
+                postings)
+            {
+                return;
+            }
+        }
+        this->data = std::move(data);
+        keyCount   = keys;
+    }
+
+#ifdef _PKSMCORE_ENABLE_MMAP
+    SearchIndex::View::View(const std::string& path)
+    {
+        size_t length = 0;
+        if (auto mapped = io::mapFile(path, length))
+        {
+            *this = View(std::move(mapped), length);
+        }
+    }
+#endif
+
+    std::pair<u32, u32> SearchIndex::View::find(Key key) const
+    {
+        // The key table is sorted, as written from a std::map
+        size_t low = 0, high = keyCount;
+        while (low < high)
+        {
+            size_t mid      = low + (high - low) / 2;
+            const u8* entry = &data[HEADER_LENGTH + ENTRY_LENGTH * mid];
+            u64 value       = LittleEndian::convertTo<u64>(entry);
+            if (value == key.value)
+            {
+                return {LittleEndian::convertTo<u32>(entry + 0x8),
+                    LittleEndian::convertTo<u32>(entry + 0xC)};
+            }
+            if (value < key.value)
+            {
+                low = mid + 1;
+            }
+            else
+            {
+                high = mid;
+            }
+        }
+        return {0, 0};
+    }
+
+    u64 SearchIndex::View::posting(u32 index) const
+    {
+        return LittleEndian::convertTo<u64>(
+            &data[HEADER_LENGTH + ENTRY_LENGTH * keyCount + 8 * size_t(index)]);
+    }
+
+    std::vector<SearchIndex::Result> SearchIndex::View::query(const std::vector<Key>& keys) const
+    {
+        std::vector<std::pair<u32, u32>> lists;
+        for (const Key& key : keys)
+        {
+            lists.push_back(find(key));
+            if (lists.back().second == 0)
+            {
+                return {};
+            }
+        }
+        if (lists.empty())
+        {
+            return {};
+        }
+
+        std::sort(lists.begin(), lists.end(),
+            [](const auto& a, const auto& b) { return a.second < b.second; });
+        std::vector<u64> candidates;
+        candidates.reserve(lists[0].second);
+        for (u32 i = 0; i < lists[0].second; i++)
+        {
+            candidates.push_back(posting(lists[0].first + i));
+        }
+        for (size_t i = 1; i < lists.size() && !candidates.empty(); i++)
+        {
+            retainIn(candidates, lists[i].second,
+                [&](size_t j) { return posting(lists[i].first + j); });
+        }
+        return toResults(candidates);
+    }
+}
@@ -0,0 +1,205 @@
+/*
+ *   This file is part of PKSM-Core
+ *   Copyright (C) 2016-2022 Bernardo Giordano, Admiral Fish, piepie62
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+ *       * Requiring preservation of specified reasonable legal notices or
+ *         author attributions in that material or in the Appropriate Legal
+ *         Notices displayed by works containing it.
+ *       * Prohibiting misrepresentation of the origin of that material,
+ *         or requiring that modified versions of such material be marked in
+ *         reasonable ways as different from the original version.
+ */
+
+#include "sav/TransferTable.hpp"
+#include "pkx/PK1.hpp"
+#include "pkx/PK2.hpp"
+#include "pkx/PK3.hpp"
+#include "utils/ValueConverter.hpp"
+#include <algorithm>
+#include <array>
+#include <memory>
+#ifndef _PKSMCORE_DISABLE_THREAD_SAFETY
+#include <mutex>
+#endif
+
+namespace pksm
+{
+    const TransferTable& TransferTable::get(Generation source, GameVersion target)
+    {
+        // One entry per source generation and target version. Once an entry is built it is only
+        // ever read, so lookups don't lock
+        struct Entry
+        {
+#ifndef _PKSMCORE_DISABLE_THREAD_SAFETY
+            std::once_flag built;
+#endif
+            std::unique_ptr<const TransferTable> table;
+        };
+        static std::array<std::array<Entry, 256>, size_t(Generation::TWO) + 1> tables;
+
+        Entry& entry = tables[size_t(source)][size_t(target)];
+#ifdef _PKSMCORE_DISABLE_THREAD_SAFETY
+        if (!entry.table)
+        {
+            entry.table.reset(new TransferTable(source, target));
+        }
+#else
+        std::call_once(entry.built,
+            [&entry, source, target] { entry.table.reset(new TransferTable(source, target)); });
+#endif
+        return *entry.table;
+    }
+
+    TransferTable::TransferTable(Generation source, GameVersion target)
+        : source(source),
+          moves(VersionTables::moveTable(target)),
+          species(VersionTables::speciesTable(target)),
+          abilities(VersionTables::abilityTable(target)),
+          balls(VersionTables::ballTable(target))
+    {
+        const Generation generation = Generation(target);
+        checkAbility                = generation > Generation::TWO && source > Generation::TWO;
+        checkBall                   = generation > Generation::TWO;
+
+        for (Species available : species)
+        {
+            forms[size_t(available)] = VersionTables::formCount(target, available);
+        }
+        // Forms that are only told apart once the Pokemon evolves
+        const auto allowEvolvedForms = [&](Species from, Species to)
+        {
+            forms[size_t(from)] =
+                std::max(forms[size_t(from)], VersionTables::formCount(target, to));
+        };
+        if (species.contains(Species::Scatterbug))
+        {
+            allowEvolvedForms(Species::Scatterbug, Species::Vivillon);
+        }
+        if (species.contains(Species::Spewpa))
+        {
+            allowEvolvedForms(Species::Spewpa, Species::Vivillon);
+        }
+        if (species.contains(Species::Mothim))
+        {
+            allowEvolvedForms(Species::Mothim, Species::Burmy);
+        }
+
+        // National IDs that come out as an item the target has, and not as nothing unless they
+        // were nothing to begin with
+        const auto convertible = [this](const VersionTables::ItemSet& targetItems, auto convert)
+        {
+            for (int item = 0; item < 2048; item++)
+            {
+                const int converted = convert(u16(item));
+                if (targetItems.contains(converted) && (converted != 0 || item == 0))
+                {
+                    items.insert(item);
+                }
+            }
+        };
+        if (generation <= Generation::TWO)
+        {
+            // Crystal only adds key items
+            const VersionTables::ItemSet& targetItems = VersionTables::itemTable(GameVersion::GD);
+            rawItems = source == Generation::ONE || source == Generation::TWO;
+            if (rawItems)
+            {
+                items = targetItems;
+            }
+            else
+            {
+                convertible(
+                    targetItems, [](u16 item) { return ItemConverter::nationalToG2(item); });
+            }
+        }
+        else if (generation == Generation::THREE)
+        {
+            rawItems = source == Generation::THREE;
+            if (rawItems)
+            {
+                items = VersionTables::itemTable(target);
+            }
+            else
+            {
+                convertible(VersionTables::itemTable(target),
+                    [](u16 item) { return ItemConverter::nationalToG3(item); });
+            }
+        }
+        else
+        {
+            rawItems = false;
+            items    = VersionTables::itemTable(target);
+            if (source == Generation::THREE)
+            {
+                items.erase(ItemConverter::ITEM_NOT_CONVERTIBLE);
+            }
+        }
+    }
+
+    int TransferTable::itemKey(const PKX& pk) const
+    {
+        if (rawItems)
+        {
+            switch (source)
+            {
+                case Generation::ONE:
+                    return static_cast<const PK1&>(pk).heldItem2();
+                case Generation::TWO:
+                    return static_cast<const PK2&>(pk).heldItem2();
+                case Generation::THREE:
+                    return static_cast<const PK3&>(pk).heldItem3();
+                default:
+                    break;
+            }
+        }
+        return pk.heldItem();
+    }
+
+    Sav::BadTransferReason TransferTable::check(const PKX& pk) const
+    {
+        for (int i = 0; i < 4; i++)
+        {
+            if (!moves.contains(pk.move(i)) || !moves.contains(pk.relearnMove(i)))
+            {
+                return Sav::BadTransferReason::MOVE;
+            }
+        }
+        if (!species.contains(pk.species()))
+        {
+            return Sav::BadTransferReason::SPECIES;
+        }
+        if (!formAllowed(pk.species(), pk.alternativeForm()))
+        {
+            return Sav::BadTransferReason::FORM;
+        }
+        if (!abilityAllowed(pk.ability()))
+        {
+            return Sav::BadTransferReason::ABILITY;
+        }
+        const int item = itemKey(pk);
+        // A source ID of nothing only passes if there really is nothing
+        if (!itemAllowed(item) || (rawItems && item == 0 && pk.heldItem() != 0))
+        {
+            return Sav::BadTransferReason::ITEM;
+        }
+        if (!ballAllowed(pk.ball()))
+        {
+            return Sav::BadTransferReason::BALL;
+        }
+        return Sav::BadTransferReason::OKAY;
+    }
+}
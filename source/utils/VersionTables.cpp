@@ -27,48 +27,37 @@
 #include "utils/VersionTables.hpp"
 #include "personal/personal.hpp"
 #include "ppCount.hpp"
-#include <algorithm>
-#include <functional>
+#include <map>
 
 namespace
 {
-    template <typename T>
-        requires std::is_enum_v<T> || std::integral<T> || requires { typename T::EnumType; }
-    inline std::set<T> create_set_consecutive(const T& begin, const T& end)
+    // std::set copies of every table returned by tableFor, keyed by the table's address. All
+    // versions are walked once on first use, so later lookups need no locking
+    template <typename T, size_t N>
+    const std::set<T>& asSet(
+        const pksm::VersionTables::IdSet<T, N>& (*tableFor)(pksm::GameVersion),
+        pksm::GameVersion version)
     {
-        std::set<T> set;
-        if constexpr (std::is_integral_v<T>)
+        using Table = pksm::VersionTables::IdSet<T, N>;
+        static const std::map<const Table*, std::set<T>> sets = [tableFor]()
         {
-            for (T i = begin; i <= end; i++)
+            std::map<const Table*, std::set<T>> ret;
+            for (int i = 0; i < 256; i++)
             {
-                set.insert(i);
+                const Table& table = tableFor(pksm::GameVersion(i));
+                ret.try_emplace(&table, table.begin(), table.end());
             }
-        }
-        else if constexpr (std::is_enum_v<T>)
-        {
-            using INT = std::underlying_type_t<T>;
-            for (INT i = INT(begin); i <= INT(end); i++)
-            {
-                set.insert(T(i));
-            }
-        }
-        else
-        {
-            using INT = std::underlying_type_t<typename T::EnumType>;
-            for (INT i = INT(begin); i <= INT(end); i++)
-            {
-                set.insert(T(i));
-            }
-        }
-        return set;
+            return ret;
+        }();
+        return sets.at(&tableFor(version));
     }
 }
 
 namespace pksm
 {
-    const std::set<int>& VersionTables::availableItems(GameVersion version)
+    const VersionTables::ItemSet& VersionTables::itemTable(GameVersion version)
     {
-        static const std::set<int> emptySet;
+        static constexpr ItemSet emptySet;
         switch (version)
         {
             case GameVersion::RD:
@@ -76,7 +65,7 @@ namespace pksm
             case GameVersion::BU:
             case GameVersion::YW:
             {
-                static const std::set<int> items = {0, 1, 2, 3, 4, 5, 6, 10, 11, 12, 13, 14, 15, 16,
+                static constexpr ItemSet items = {0, 1, 2, 3, 4, 5, 6, 10, 11, 12, 13, 14, 15, 16,
                     17, 18, 19, 20, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 45,
                     46, 47, 48, 49, 51, 52, 53, 54, 55, 56, 57, 58, 60, 61, 62, 63, 64, 65, 66, 67,
                     68, 69, 70, 71, 72, 73, 74, 75, 76, 77, 78, 79, 80, 81, 82, 83, 196, 197, 198,
@@ -89,7 +78,7 @@ namespace pksm
             case GameVersion::GD:
             case GameVersion::SV:
             {
-                static const std::set<int> items = {0, 1, 2, 3, 4, 5, 7, 8, 9, 10, 11, 12, 13, 14,
+                static constexpr ItemSet items = {0, 1, 2, 3, 4, 5, 7, 8, 9, 10, 11, 12, 13, 14,
                     15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35,
                     36, 37, 38, 39, 40, 41, 42, 43, 44, 46, 47, 48, 49, 51, 52, 53, 54, 55, 57, 58,
                     59, 60, 61, 62, 63, 64, 65, 66, 67, 68, 69, 71, 72, 73, 74, 75, 76, 77, 78, 79,
@@ -106,7 +95,7 @@ namespace pksm
             }
             case GameVersion::C:
             {
-                static const std::set<int> items = {0, 1, 2, 3, 4, 5, 7, 8, 9, 10, 11, 12, 13, 14,
+                static constexpr ItemSet items = {0, 1, 2, 3, 4, 5, 7, 8, 9, 10, 11, 12, 13, 14,
                     15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35,
                     36, 37, 38, 39, 40, 41, 42, 43, 44, 46, 47, 48, 49, 51, 52, 53, 54, 55, 57, 58,
                     59, 60, 61, 62, 63, 64, 65, 66, 67, 68, 69, 70, 71, 72, 73, 74, 75, 76, 77, 78,
@@ -124,89 +113,77 @@ namespace pksm
             case GameVersion::R:
             case GameVersion::S:
             {
-                static const std::set<int> items =
-                    std::invoke([]() { return create_set_consecutive<int>(0, 348); });
+                static constexpr ItemSet items = ItemSet::range(0, 348);
                 return items;
             }
             case GameVersion::FR:
             case GameVersion::LG:
             {
-                static const std::set<int> items =
-                    std::invoke([]() { return create_set_consecutive<int>(0, 374); });
+                static constexpr ItemSet items = ItemSet::range(0, 374);
                 return items;
             }
             case GameVersion::E:
             {
-                static const std::set<int> items =
-                    std::invoke([]() { return create_set_consecutive<int>(0, 376); });
+                static constexpr ItemSet items = ItemSet::range(0, 376);
                 return items;
             }
             case GameVersion::D:
             case GameVersion::P:
             {
-                static const std::set<int> items =
-                    std::invoke([]() { return create_set_consecutive<int>(0, 464); });
+                static constexpr ItemSet items = ItemSet::range(0, 464);
                 return items;
             }
             case GameVersion::Pt:
             {
-                static const std::set<int> items =
-                    std::invoke([]() { return create_set_consecutive<int>(0, 467); });
+                static constexpr ItemSet items = ItemSet::range(0, 467);
                 return items;
             }
             case GameVersion::HG:
             case GameVersion::SS:
             {
-                static const std::set<int> items =
-                    std::invoke([]() { return create_set_consecutive<int>(0, 536); });
+                static constexpr ItemSet items = ItemSet::range(0, 536);
                 return items;
             }
             case GameVersion::B:
             case GameVersion::W:
             {
-                static const std::set<int> items =
-                    std::invoke([]() { return create_set_consecutive<int>(0, 632); });
+                static constexpr ItemSet items = ItemSet::range(0, 632);
                 return items;
             }
             case GameVersion::B2:
             case GameVersion::W2:
             {
-                static const std::set<int> items =
-                    std::invoke([]() { return create_set_consecutive<int>(0, 638); });
+                static constexpr ItemSet items = ItemSet::range(0, 638);
                 return items;
             }
             case GameVersion::X:
             case GameVersion::Y:
             {
-                static const std::set<int> items =
-                    std::invoke([]() { return create_set_consecutive<int>(0, 717); });
+                static constexpr ItemSet items = ItemSet::range(0, 717);
                 return items;
             }
             case GameVersion::OR:
             case GameVersion::AS:
             {
-                static const std::set<int> items =
-                    std::invoke([]() { return create_set_consecutive<int>(0, 775); });
+                static constexpr ItemSet items = ItemSet::range(0, 775);
                 return items;
             }
             case GameVersion::SN:
             case GameVersion::MN:
             {
-                static const std::set<int> items =
-                    std::invoke([]() { return create_set_consecutive<int>(0, 920); });
+                static constexpr ItemSet items = ItemSet::range(0, 920);
                 return items;
             }
             case GameVersion::US:
             case GameVersion::UM:
             {
-                static const std::set<int> items =
-                    std::invoke([]() { return create_set_consecutive<int>(0, 959); });
+                static constexpr ItemSet items = ItemSet::range(0, 959);
                 return items;
             }
             case GameVersion::GE:
             case GameVersion::GP:
             {
-                static const std::set<int> items = {0, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27,
+                static constexpr ItemSet items = {0, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27,
                     28, 29, 30, 31, 32, 38, 39, 40, 41, 709, 903, 328, 329, 330, 331, 332, 333, 334,
                     335, 336, 337, 338, 339, 340, 341, 342, 343, 344, 345, 346, 347, 348, 349, 350,
                     351, 352, 353, 354, 355, 356, 357, 358, 359, 360, 361, 362, 363, 364, 365, 366,
@@ -230,8 +207,7 @@ namespace pksm
             case GameVersion::SW:
             case GameVersion::SH:
             {
-                static const std::set<int> items =
-                    std::invoke([]() { return create_set_consecutive<int>(0, 1607); });
+                static constexpr ItemSet items = ItemSet::range(0, 1607);
                 return items;
             }
             default:
@@ -239,9 +215,9 @@ namespace pksm
         }
     }
 
-    const std::set<Move>& VersionTables::availableMoves(GameVersion version)
+    const VersionTables::MoveSet& VersionTables::moveTable(GameVersion version)
     {
-        static const std::set<Move> emptySet;
+        static constexpr MoveSet emptySet;
         switch (version)
         {
             case GameVersion::RD:
@@ -249,16 +225,14 @@ namespace pksm
             case GameVersion::BU:
             case GameVersion::YW:
             {
-                static const std::set<Move> items = std::invoke(
-                    []() { return create_set_consecutive<Move>(Move::None, Move::Struggle); });
+                static constexpr MoveSet items = MoveSet::range(Move::None, Move::Struggle);
                 return items;
             }
             case GameVersion::GD:
             case GameVersion::SV:
             case GameVersion::C:
             {
-                static const std::set<Move> items = std::invoke(
-                    []() { return create_set_consecutive<Move>(Move::None, Move::BeatUp); });
+                static constexpr MoveSet items = MoveSet::range(Move::None, Move::BeatUp);
                 return items;
             }
             case GameVersion::R:
@@ -267,8 +241,7 @@ namespace pksm
             case GameVersion::LG:
             case GameVersion::E:
             {
-                static const std::set<Move> items = std::invoke(
-                    []() { return create_set_consecutive<Move>(Move::None, Move::PsychoBoost); });
+                static constexpr MoveSet items = MoveSet::range(Move::None, Move::PsychoBoost);
                 return items;
             }
             case GameVersion::D:
@@ -277,8 +250,7 @@ namespace pksm
             case GameVersion::HG:
             case GameVersion::SS:
             {
-                static const std::set<Move> items = std::invoke(
-                    []() { return create_set_consecutive<Move>(Move::None, Move::ShadowForce); });
+                static constexpr MoveSet items = MoveSet::range(Move::None, Move::ShadowForce);
                 return items;
             }
             case GameVersion::B:
@@ -286,44 +258,38 @@ namespace pksm
             case GameVersion::B2:
             case GameVersion::W2:
             {
-                static const std::set<Move> items = std::invoke(
-                    []() { return create_set_consecutive<Move>(Move::None, Move::FusionBolt); });
+                static constexpr MoveSet items = MoveSet::range(Move::None, Move::FusionBolt);
                 return items;
             }
             case GameVersion::X:
             case GameVersion::Y:
             {
-                static const std::set<Move> items = std::invoke(
-                    []() { return create_set_consecutive<Move>(Move::None, Move::LightofRuin); });
+                static constexpr MoveSet items = MoveSet::range(Move::None, Move::LightofRuin);
                 return items;
             }
             case GameVersion::OR:
             case GameVersion::AS:
             {
-                static const std::set<Move> items = std::invoke([]()
-                    { return create_set_consecutive<Move>(Move::None, Move::HyperspaceFury); });
+                static constexpr MoveSet items = MoveSet::range(Move::None, Move::HyperspaceFury);
                 return items;
             }
             case GameVersion::SN:
             case GameVersion::MN:
             {
-                static const std::set<Move> items = std::invoke(
-                    []() { return create_set_consecutive<Move>(Move::None, Move::MindBlown); });
+                static constexpr MoveSet items = MoveSet::range(Move::None, Move::MindBlown);
                 return items;
             }
             case GameVersion::US:
             case GameVersion::UM:
             {
-                static const std::set<Move> items = std::invoke(
-                    []() {
-                        return create_set_consecutive<Move>(Move::None, Move::ClangorousSoulblaze);
-                    });
+                static constexpr MoveSet items =
+                    MoveSet::range(Move::None, Move::ClangorousSoulblaze);
                 return items;
             }
             case GameVersion::GE:
             case GameVersion::GP:
             {
-                static const std::set<Move> items = {Move::None, Move::Pound, Move::KarateChop,
+                static constexpr MoveSet items = {Move::None, Move::Pound, Move::KarateChop,
                     Move::DoubleSlap, Move::CometPunch, Move::MegaPunch, Move::PayDay,
                     Move::FirePunch, Move::IcePunch, Move::ThunderPunch, Move::Scratch,
                     Move::ViseGrip, Move::Guillotine, Move::RazorWind, Move::SwordsDance, Move::Cut,
@@ -379,8 +345,7 @@ namespace pksm
             case GameVersion::SW:
             case GameVersion::SH:
             {
-                static const std::set<Move> items = std::invoke(
-                    []() { return create_set_consecutive<Move>(Move::None, Move::EerieSpell); });
+                static constexpr MoveSet items = MoveSet::range(Move::None, Move::EerieSpell);
                 return items;
             }
             default:
@@ -388,9 +353,9 @@ namespace pksm
         }
     }
 
-    const std::set<Species>& VersionTables::availableSpecies(GameVersion version)
+    const VersionTables::SpeciesSet& VersionTables::speciesTable(GameVersion version)
     {
-        static const std::set<Species> emptySet;
+        static constexpr SpeciesSet emptySet;
         switch (version)
         {
             case GameVersion::RD:
@@ -398,18 +363,16 @@ namespace pksm
             case GameVersion::BU:
             case GameVersion::YW:
             {
-                static const std::set<Species> items = std::invoke([]()
-                    { return create_set_consecutive<Species>(Species::Bulbasaur, Species::Mew); });
+                static constexpr SpeciesSet items =
+                    SpeciesSet::range(Species::Bulbasaur, Species::Mew);
                 return items;
             }
             case GameVersion::GD:
             case GameVersion::SV:
             case GameVersion::C:
             {
-                static const std::set<Species> items = std::invoke(
-                    []() {
-                        return create_set_consecutive<Species>(Species::Bulbasaur, Species::Celebi);
-                    });
+                static constexpr SpeciesSet items =
+                    SpeciesSet::range(Species::Bulbasaur, Species::Celebi);
                 return items;
             }
             case GameVersion::R:
@@ -418,10 +381,8 @@ namespace pksm
             case GameVersion::LG:
             case GameVersion::E:
             {
-                static const std::set<Species> items = std::invoke(
-                    []() {
-                        return create_set_consecutive<Species>(Species::Bulbasaur, Species::Deoxys);
-                    });
+                static constexpr SpeciesSet items =
+                    SpeciesSet::range(Species::Bulbasaur, Species::Deoxys);
                 return items;
             }
             case GameVersion::D:
@@ -430,10 +391,8 @@ namespace pksm
             case GameVersion::HG:
             case GameVersion::SS:
             {
-                static const std::set<Species> items = std::invoke(
-                    []() {
-                        return create_set_consecutive<Species>(Species::Bulbasaur, Species::Arceus);
-                    });
+                static constexpr SpeciesSet items =
+                    SpeciesSet::range(Species::Bulbasaur, Species::Arceus);
                 return items;
             }
             case GameVersion::B:
@@ -441,11 +400,8 @@ namespace pksm
             case GameVersion::B2:
             case GameVersion::W2:
             {
-                static const std::set<Species> items = std::invoke(
-                    []() {
-                        return create_set_consecutive<Species>(
-                            Species::Bulbasaur, Species::Genesect);
-                    });
+                static constexpr SpeciesSet items =
+                    SpeciesSet::range(Species::Bulbasaur, Species::Genesect);
                 return items;
             }
             case GameVersion::X:
@@ -453,51 +409,40 @@ namespace pksm
             case GameVersion::OR:
             case GameVersion::AS:
             {
-                static const std::set<Species> items = std::invoke(
-                    []() {
-                        return create_set_consecutive<Species>(
-                            Species::Bulbasaur, Species::Volcanion);
-                    });
+                static constexpr SpeciesSet items =
+                    SpeciesSet::range(Species::Bulbasaur, Species::Volcanion);
                 return items;
             }
             case GameVersion::SN:
             case GameVersion::MN:
             {
-                static const std::set<Species> items = std::invoke(
-                    []() {
-                        return create_set_consecutive<Species>(
-                            Species::Bulbasaur, Species::Marshadow);
-                    });
+                static constexpr SpeciesSet items =
+                    SpeciesSet::range(Species::Bulbasaur, Species::Marshadow);
                 return items;
             }
             case GameVersion::US:
             case GameVersion::UM:
             {
-                static const std::set<Species> items = std::invoke(
-                    []() {
-                        return create_set_consecutive<Species>(
-                            Species::Bulbasaur, Species::Zeraora);
-                    });
+                static constexpr SpeciesSet items =
+                    SpeciesSet::range(Species::Bulbasaur, Species::Zeraora);
                 return items;
             }
             case GameVersion::GE:
             case GameVersion::GP:
             {
-                static const std::set<Species> items = std::invoke(
-                    []()
-                    {
-                        auto ret =
-                            create_set_consecutive<Species>(Species::Bulbasaur, Species::Mew);
-                        ret.emplace(Species::Meltan);
-                        ret.emplace(Species::Melmetal);
-                        return ret;
-                    });
+                static constexpr SpeciesSet items = []()
+                {
+                    SpeciesSet ret = SpeciesSet::range(Species::Bulbasaur, Species::Mew);
+                    ret.insert(Species::Meltan);
+                    ret.insert(Species::Melmetal);
+                    return ret;
+                }();
                 return items;
             }
             case GameVersion::SW:
             case GameVersion::SH:
             {
-                static const std::set<Species> items = {Species::Bulbasaur, Species::Ivysaur,
+                static constexpr SpeciesSet items = {Species::Bulbasaur, Species::Ivysaur,
                     Species::Venusaur, Species::Charmander, Species::Charmeleon, Species::Charizard,
                     Species::Squirtle, Species::Wartortle, Species::Blastoise, Species::Caterpie,
                     Species::Metapod, Species::Butterfree, Species::Pikachu, Species::Raichu,
@@ -677,9 +622,9 @@ namespace pksm
         }
     }
 
-    const std::set<Ability>& VersionTables::availableAbilities(GameVersion version)
+    const VersionTables::AbilitySet& VersionTables::abilityTable(GameVersion version)
     {
-        static const std::set<Ability> emptySet;
+        static constexpr AbilitySet emptySet;
         switch (version)
         {
             case GameVersion::RD:
@@ -687,14 +632,14 @@ namespace pksm
             case GameVersion::BU:
             case GameVersion::YW:
             {
-                static const std::set<Ability> items = {Ability::None};
+                static constexpr AbilitySet items = {Ability::None};
                 return items;
             }
             case GameVersion::GD:
             case GameVersion::SV:
             case GameVersion::C:
             {
-                static const std::set<Ability> items = {Ability::None};
+                static constexpr AbilitySet items = {Ability::None};
                 return items;
             }
             case GameVersion::R:
@@ -703,11 +648,8 @@ namespace pksm
             case GameVersion::LG:
             case GameVersion::E:
             {
-                static const std::set<Ability> items = std::invoke(
-                    []() {
-                        return create_set_consecutive<Ability>(
-                            Ability::Stench, Ability::TangledFeet);
-                    });
+                static constexpr AbilitySet items =
+                    AbilitySet::range(Ability::Stench, Ability::TangledFeet);
                 return items;
             }
             case GameVersion::D:
@@ -716,10 +658,8 @@ namespace pksm
             case GameVersion::HG:
             case GameVersion::SS:
             {
-                static const std::set<Ability> items = std::invoke(
-                    []() {
-                        return create_set_consecutive<Ability>(Ability::Stench, Ability::BadDreams);
-                    });
+                static constexpr AbilitySet items =
+                    AbilitySet::range(Ability::Stench, Ability::BadDreams);
                 return items;
             }
             case GameVersion::B:
@@ -727,66 +667,50 @@ namespace pksm
             case GameVersion::B2:
             case GameVersion::W2:
             {
-                static const std::set<Ability> items = std::invoke(
-                    []() {
-                        return create_set_consecutive<Ability>(Ability::Stench, Ability::Teravolt);
-                    });
+                static constexpr AbilitySet items =
+                    AbilitySet::range(Ability::Stench, Ability::Teravolt);
                 return items;
             }
             case GameVersion::X:
             case GameVersion::Y:
             {
-                static const std::set<Ability> items = std::invoke(
-                    []() {
-                        return create_set_consecutive<Ability>(Ability::Stench, Ability::AuraBreak);
-                    });
+                static constexpr AbilitySet items =
+                    AbilitySet::range(Ability::Stench, Ability::AuraBreak);
                 return items;
             }
             case GameVersion::OR:
             case GameVersion::AS:
             {
-                static const std::set<Ability> items = std::invoke(
-                    []() {
-                        return create_set_consecutive<Ability>(
-                            Ability::Stench, Ability::DeltaStream);
-                    });
+                static constexpr AbilitySet items =
+                    AbilitySet::range(Ability::Stench, Ability::DeltaStream);
                 return items;
             }
             case GameVersion::SN:
             case GameVersion::MN:
             {
-                static const std::set<Ability> items = std::invoke(
-                    []() {
-                        return create_set_consecutive<Ability>(
-                            Ability::Stench, Ability::PrismArmor);
-                    });
+                static constexpr AbilitySet items =
+                    AbilitySet::range(Ability::Stench, Ability::PrismArmor);
                 return items;
             }
             case GameVersion::US:
             case GameVersion::UM:
             {
-                static const std::set<Ability> items = std::invoke(
-                    []() {
-                        return create_set_consecutive<Ability>(
-                            Ability::Stench, Ability::Neuroforce);
-                    });
+                static constexpr AbilitySet items =
+                    AbilitySet::range(Ability::Stench, Ability::Neuroforce);
                 return items;
             }
             case GameVersion::GE:
             case GameVersion::GP:
             {
-                static const std::set<Ability> items = std::invoke(
-                    []() {
-                        return create_set_consecutive<Ability>(
-                            Ability::Stench, Ability::Neuroforce);
-                    });
+                static constexpr AbilitySet items =
+                    AbilitySet::range(Ability::Stench, Ability::Neuroforce);
                 return items;
             }
             case GameVersion::SW:
             case GameVersion::SH:
             {
-                static const std::set<Ability> items = std::invoke([]()
-                    { return create_set_consecutive<Ability>(Ability::Stench, Ability::AsOneG); });
+                static constexpr AbilitySet items =
+                    AbilitySet::range(Ability::Stench, Ability::AsOneG);
                 return items;
             }
             default:
@@ -794,49 +718,44 @@ namespace pksm
         }
     }
 
-    const std::set<Ball>& VersionTables::availableBalls(GameVersion version)
+    const VersionTables::BallSet& VersionTables::ballTable(GameVersion version)
     {
-        static const std::set<Ball> emptySet;
+        static constexpr BallSet emptySet;
         switch ((Generation)version)
         {
             case Generation::ONE:
             {
-                static const std::set<Ball> items = std::invoke(
-                    []() { return create_set_consecutive<Ball>(Ball::Master, Ball::Safari); });
+                static constexpr BallSet items = BallSet::range(Ball::Master, Ball::Safari);
                 return items;
             }
             case Generation::TWO:
             {
-                static const std::set<Ball> items = {Ball::Master, Ball::Ultra, Ball::Great,
+                static constexpr BallSet items = {Ball::Master, Ball::Ultra, Ball::Great,
                     Ball::Poke, Ball::Safari, Ball::Fast, Ball::Level, Ball::Lure, Ball::Heavy,
                     Ball::Love, Ball::Friend, Ball::Moon};
                 return items;
             }
             case Generation::THREE:
             {
-                static const std::set<Ball> items = std::invoke(
-                    []() { return create_set_consecutive<Ball>(Ball::Master, Ball::Premier); });
+                static constexpr BallSet items = BallSet::range(Ball::Master, Ball::Premier);
                 return items;
             }
             case Generation::FOUR:
             {
-                static const std::set<Ball> items = std::invoke(
-                    []() { return create_set_consecutive<Ball>(Ball::Master, Ball::Sport); });
+                static constexpr BallSet items = BallSet::range(Ball::Master, Ball::Sport);
                 return items;
             }
             case Generation::FIVE:
             case Generation::SIX:
             {
-                static const std::set<Ball> items = std::invoke(
-                    []() { return create_set_consecutive<Ball>(Ball::Master, Ball::Dream); });
+                static constexpr BallSet items = BallSet::range(Ball::Master, Ball::Dream);
                 return items;
             }
             case Generation::SEVEN:
             case Generation::LGPE:
             case Generation::EIGHT:
             {
-                static const std::set<Ball> items = std::invoke(
-                    []() { return create_set_consecutive<Ball>(Ball::Master, Ball::Beast); });
+                static constexpr BallSet items = BallSet::range(Ball::Master, Ball::Beast);
                 return items;
             }
             default:
@@ -844,6 +763,31 @@ namespace pksm
         }
     }
 
+    const std::set<int>& VersionTables::availableItems(GameVersion version)
+    {
+        return asSet(&itemTable, version);
+    }
+
+    const std::set<Move>& VersionTables::availableMoves(GameVersion version)
+    {
+        return asSet(&moveTable, version);
+    }
+
+    const std::set<Species>& VersionTables::availableSpecies(GameVersion version)
+    {
+        return asSet(&speciesTable, version);
+    }
+
+    const std::set<Ability>& VersionTables::availableAbilities(GameVersion version)
+    {
+        return asSet(&abilityTable, version);
+    }
+
+    const std::set<Ball>& VersionTables::availableBalls(GameVersion version)
+    {
+        return asSet(&ballTable, version);
+    }
+
     int VersionTables::maxItem(GameVersion version)
     {
         switch (version)
@@ -1177,91 +1121,36 @@ namespace pksm
         {
             return 0;
         }
-        u8 val = 0;
+        const std::array<u8, internal::PP_G8.size()>* table;
         switch (gen)
         {
+            // No differences between SM and SWSH
             case pksm::Generation::EIGHT:
             case pksm::Generation::SEVEN:
-                val = internal::PP_G8[size_t(move)];
+                table = &internal::PP_G8;
                 break;
             case pksm::Generation::SIX:
-            {
-                auto found = std::find_if(internal::PPDiff_G6.begin(), internal::PPDiff_G6.end(),
-                    [move](const std::pair<pksm::Move, u8>& v) { return v.first == move; });
-                if (found != internal::PPDiff_G6.end())
-                {
-                    val = found->second;
-                }
-                else
-                {
-                    val = internal::PP_G8[size_t(move)];
-                }
-            }
-            break;
+                table = &internal::PP_G6;
+                break;
             case pksm::Generation::FIVE:
-            {
-                auto found = std::find_if(internal::PPDiff_G5.begin(), internal::PPDiff_G5.end(),
-                    [move](const std::pair<pksm::Move, u8>& v) { return v.first == move; });
-                if (found != internal::PPDiff_G5.end())
-                {
-                    val = found->second;
-                }
-                else
-                {
-                    val = internal::PP_G8[size_t(move)];
-                }
-            }
-            break;
+                table = &internal::PP_G5;
+                break;
             case pksm::Generation::FOUR:
-            {
-                auto found = std::find_if(internal::PPDiff_G4.begin(), internal::PPDiff_G4.end(),
-                    [move](const std::pair<pksm::Move, u8>& v) { return v.first == move; });
-                if (found != internal::PPDiff_G4.end())
-                {
-                    val = found->second;
-                }
-                else
-                {
-                    val = internal::PP_G8[size_t(move)];
-                }
-            }
-            break;
+                table = &internal::PP_G4;
+                break;
             // So... no PP changes for Gen I and II moves occurred until Gen IV. Nice.
             case pksm::Generation::ONE:
             case pksm::Generation::TWO:
             case pksm::Generation::THREE:
-            {
-                auto found =
-                    std::find_if(internal::PPDiff_G123.begin(), internal::PPDiff_G123.end(),
-                        [move](const std::pair<pksm::Move, u8>& v) { return v.first == move; });
-                if (found != internal::PPDiff_G123.end())
-                {
-                    val = found->second;
-                }
-                else
-                {
-                    val = internal::PP_G8[size_t(move)];
-                }
-            }
-            break;
+                table = &internal::PP_G123;
+                break;
             case pksm::Generation::LGPE:
-            {
-                auto found =
-                    std::find_if(internal::PPDiff_LGPE.begin(), internal::PPDiff_LGPE.end(),
-                        [move](const std::pair<pksm::Move, u8>& v) { return v.first == move; });
-                if (found != internal::PPDiff_LGPE.end())
-                {
-                    val = found->second;
-                }
-                else
-                {
-                    val = internal::PP_G8[size_t(move)];
-                }
-            }
-            break;
+                table = &internal::PP_LGPE;
+                break;
             default:
                 return 0;
         }
+        const u8 val = (*table)[size_t(move)];
 
         // Stupid thing G1/2 does: they can't store above 63 for PP value
         if (gen <= pksm::Generation::TWO && val == 40)
@@ -272,32 +272,55 @@ namespace pksm::crypto::swsh
         }
     }
 
-    void SCBlock::encrypt()
+    void SCBlock::applyXor(u8* buffer) const
     {
-        if (!currentlyEncrypted)
+        internal::XorShift32 xorShift(LittleEndian::convertTo<u32>(buffer + myOffset));
+        for (size_t i = 0; i < encryptedDataSize() - 4; i++)
         {
-            internal::XorShift32 xorShift(key());
-            for (size_t i = 0; i < encryptedDataSize() - 4; i++)
-            {
-                data[myOffset + 4 + i] ^= xorShift.next();
-            }
+            buffer[myOffset + 4 + i] ^= xorShift.next();
+        }
+    }
+
+    void SCBlock::encryptCopy(u8* image) const
+    {
+        applyXor(image);
+    }
 
-            currentlyEncrypted = true;
+    void SCBlock::encrypt()
+    {
+        if (state == CryptState::DECRYPTED)
+        {
+            applyXor(data.get());
+            state = CryptState::ENCRYPTED;
         }
     }
 
     void SCBlock::decrypt()
     {
-        if (currentlyEncrypted)
+#ifdef _PKSMCORE_DISABLE_THREAD_SAFETY
+        if (state == CryptState::ENCRYPTED)
+        {
+            applyXor(data.get());
+            state = CryptState::DECRYPTED;
+        }
+#else
+        CryptState expected = CryptState::ENCRYPTED;
+        // Whoever wins the exchange decrypts; everyone else waits until the data is usable
+        if (state.compare_exchange_strong(expected, CryptState::DECRYPTING))
+        {
+            applyXor(data.get());
+            state = CryptState::DECRYPTED;
+            state.notify_all();
+        }
+        else
         {
-            internal::XorShift32 xorShift(key());
-            for (size_t i = 0; i < encryptedDataSize() - 4; i++)
+            while (expected == CryptState::DECRYPTING)
             {
-                data[myOffset + 4 + i] ^= xorShift.next();
+                state.wait(CryptState::DECRYPTING);
+                expected = state;
             }
-
-            currentlyEncrypted = false;
         }
+#endif
     }
 
     u32 SCBlock::key() const
@@ -361,7 +384,7 @@ namespace pksm::crypto::swsh
         }
     }
 
-    size_t SCBlock::encryptedDataSize()
+    size_t SCBlock::encryptedDataSize() const
     {
         static constexpr int baseSize = 4 + 1; // key + type
         switch (type)
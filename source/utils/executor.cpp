@@ -0,0 +1,271 @@
+/*
+ *   This file is part of PKSM-Core
+ *   Copyright (C) 2016-2022 Bernardo Giordano, Admiral Fish, piepie62
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+ *       * Requiring preservation of specified reasonable legal notices or
+ *         author attributions in that material or in the Appropriate Legal
+ *         Notices displayed by works containing it.
+ *       * Prohibiting misrepresentation of the origin of that material,
+ *         or requiring that modified versions of such material be marked in
+ *         reasonable ways as different from the original version.
+ */
+
+#include "utils/executor.hpp"
+#include <algorithm>
+#include <exception>
+
+namespace
+{
+#ifndef _PKSMCORE_DISABLE_THREAD_SAFETY
+    // Enough pieces per thread that stealing can even out uneven tasks
+    constexpr size_t CHUNKS_PER_THREAD = 4;
+
+    struct Job
+    {
+        const std::function<void(size_t)>& task;
+        std::atomic<size_t> remaining;
+        std::mutex errorLock;
+        std::exception_ptr error;
+
+        Job(const std::function<void(size_t)>& task, size_t chunks)
+            : task(task), remaining(chunks)
+        {
+        }
+
+        void run(size_t begin, size_t end)
+        {
+            try
+            {
+                for (size_t i = begin; i < end; i++)
+                {
+                    task(i);
+                }
+            }
+            catch (...)
+            {
+                std::lock_guard lock(errorLock);
+                if (!error)
+                {
+                    error = std::current_exception();
+                }
+            }
+            if (--remaining == 0)
+            {
+                remaining.notify_all();
+            }
+        }
+    };
+
+    // Guarded by a mutex rather than held in a std::atomic<std::shared_ptr>, which libc++ lacks
+    std::mutex currentExecutorLock;
+    std::shared_ptr<pksm::Executor> currentExecutor;
+#else
+    std::shared_ptr<pksm::Executor> currentExecutor;
+#endif
+
+    std::shared_ptr<pksm::Executor> defaultExecutor()
+    {
+#ifdef _PKSMCORE_DISABLE_THREAD_SAFETY
+        static std::shared_ptr<pksm::Executor> executor = std::make_shared<pksm::InlineExecutor>();
+#else
+        static std::shared_ptr<pksm::Executor> executor = std::make_shared<pksm::ThreadPool>();
+#endif
+        return executor;
+    }
+}
+
+namespace pksm
+{
+    void InlineExecutor::parallelFor(size_t count, const std::function<void(size_t)>& task)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            task(i);
+        }
+    }
+
+#ifndef _PKSMCORE_DISABLE_THREAD_SAFETY
+    ThreadPool::ThreadPool()
+        : ThreadPool(std::max(std::thread::hardware_concurrency(), 1u) - 1)
+    {
+    }
+
+    ThreadPool::ThreadPool(size_t threads)
+    {
+        for (size_t i = 0; i < threads; i++)
+        {
+            queues.emplace_back(std::make_unique<Queue>());
+        }
+        workers.reserve(threads);
+        for (size_t i = 0; i < threads; i++)
+        {
+            workers.emplace_back(&ThreadPool::work, this, i);
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard lock(sleepLock);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto& worker : workers)
+        {
+            worker.join();
+        }
+    }
+
+    void ThreadPool::work(size_t home)
+    {
+        while (true)
+        {
+            if (runOne(home))
+            {
+                continue;
+            }
+            std::unique_lock lock(sleepLock);
+            wake.wait(lock, [this] { return stopping || queued > 0; });
+            if (queued <= 0)
+            {
+                return;
+            }
+        }
+    }
+
+    bool ThreadPool::runOne(size_t home)
+    {
+        std::function<void()> task;
+        {
+            Queue& own = *queues[home];
+            std::lock_guard lock(own.lock);
+            if (!own.tasks.empty())
+            {
+                task = std::move(own.tasks.back());
+                own.tasks.pop_back();
+            }
+        }
+        for (size_t i = 1; !task && i < queues.size(); i++)
+        {
+            Queue& victim = *queues[(home + i) % queues.size()];
+            std::lock_guard lock(victim.lock);
+            if (!victim.tasks.empty())
+            {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+            }
+        }
+        if (!task)
+        {
+            return false;
+        }
+        queued--;
+        task();
+        return true;
+    }
+
+    void ThreadPool::parallelFor(size_t count, const std::function<void(size_t)>& task)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+        if (workers.empty() || count == 1)
+        {
+            InlineExecutor{}.parallelFor(count, task);
+            return;
+        }
+
+        const size_t pieces = std::min(count, concurrency() * CHUNKS_PER_THREAD);
+        const size_t size   = (count + pieces - 1) / pieces;
+        const size_t chunks = (count + size - 1) / size;
+        auto job            = std::make_shared<Job>(task, chunks);
+
+        // Deal the chunks out across the workers' queues, starting somewhere different each call
+        // so that concurrent callers don't all pile onto the same worker
+        const size_t first = nextQueue++;
+        size_t target      = first;
+        for (size_t begin = 0; begin < count; begin += size, target++)
+        {
+            const size_t end = std::min(begin + size, count);
+            Queue& queue     = *queues[target % queues.size()];
+            std::lock_guard lock(queue.lock);
+            queue.tasks.emplace_back([job, begin, end] { job->run(begin, end); });
+        }
+        {
+            std::lock_guard lock(sleepLock);
+            queued += ptrdiff_t(chunks);
+        }
+        wake.notify_all();
+
+        // Help with whatever is queued, ours or not, until our own chunks are done
+        while (size_t left = job->remaining)
+        {
+            if (!runOne(first % queues.size()))
+            {
+                job->remaining.wait(left);
+            }
+        }
+
+        if (job->error)
+        {
+            std::rethrow_exception(job->error);
+        }
+    }
+
+    void ThreadPool::post(std::function<void()> task)
+    {
+        if (workers.empty())
+        {
+            task();
+            return;
+        }
+
+        {
+            Queue& queue = *queues[nextQueue++ % queues.size()];
+            std::lock_guard lock(queue.lock);
+            queue.tasks.emplace_back(std::move(task));
+        }
+        {
+            std::lock_guard lock(sleepLock);
+            queued++;
+        }
+        wake.notify_one();
+    }
+#endif
+
+    std::shared_ptr<Executor> executor()
+    {
+        std::shared_ptr<Executor> ret;
+        {
+#ifndef _PKSMCORE_DISABLE_THREAD_SAFETY
+            std::lock_guard lock(currentExecutorLock);
+#endif
+            ret = currentExecutor;
+        }
+        return ret ? ret : defaultExecutor();
+    }
+
+    void executor(std::shared_ptr<Executor> executor)
+    {
+#ifndef _PKSMCORE_DISABLE_THREAD_SAFETY
+        std::lock_guard lock(currentExecutorLock);
+#endif
+        // The old executor is released after unlocking, so destroying it can't block other callers
+        executor.swap(currentExecutor);
+    }
+}
@@ -25,6 +25,8 @@
  */
 
 #include "utils/flagUtil.hpp"
+#include "utils/endian.hpp"
+#include <bit>
 
 bool pksm::FlagUtil::getFlag(const u8* data, int offset, int bitIndex)
 {
@@ -38,3 +40,33 @@ void pksm::FlagUtil::setFlag(u8* data, int offset, int bitIndex, bool v)
     data[offset] &= ~(1 << bitIndex);
     data[offset] |= (v ? 1 : 0) << bitIndex;
 }
+
+int pksm::FlagUtil::countFlags(std::initializer_list<const u8*> regions, int bitCount)
+{
+    int ret = 0;
+    int bit = 0;
+    for (; bit + 64 <= bitCount; bit += 64)
+    {
+        u64 word = 0;
+        for (const u8* region : regions)
+        {
+            word |= LittleEndian::convertTo<u64>(region + bit / 8);
+        }
+        ret += std::popcount(word);
+    }
+    // Whatever is left, which may end partway through a byte
+    for (; bit < bitCount; bit += 8)
+    {
+        u8 byte = 0;
+        for (const u8* region : regions)
+        {
+            byte |= region[bit / 8];
+        }
+        if (bitCount - bit < 8)
+        {
+            byte &= (1 << (bitCount - bit)) - 1;
+        }
+        ret += std::popcount(byte);
+    }
+    return ret;
+}
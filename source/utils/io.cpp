@@ -28,8 +28,155 @@
 #include <sys/stat.h>
 #include <unistd.h>
 
+#ifdef _PKSMCORE_ENABLE_MMAP
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <vector>
+
+namespace
+{
+    // Which pages of a private file mapping have been copied on write, going by the kernel's page
+    // table. Returns false where that isn't available
+    bool writtenPages(const u8* data, size_t pages, size_t pageSize, std::vector<bool>& written)
+    {
+#ifdef __linux__
+        int fd = open("/proc/self/pagemap", O_RDONLY);
+        if (fd < 0)
+        {
+            return false;
+        }
+        std::vector<u64> entries(pages);
+        off_t offset = (reinterpret_cast<uintptr_t>(data) / pageSize) * sizeof(u64);
+        bool ok      = pread(fd, entries.data(), pages * sizeof(u64), offset) ==
+                  ssize_t(pages * sizeof(u64));
+        close(fd);
+        if (!ok)
+        {
+            return false;
+        }
+        written.resize(pages);
+        for (size_t i = 0; i < pages; i++)
+        {
+            bool present = entries[i] & (u64(1) << 63);
+            bool swapped = entries[i] & (u64(1) << 62);
+            bool file    = entries[i] & (u64(1) << 61);
+            // A page that left the page cache is a private copy
+            written[i] = swapped || (present && !file);
+        }
+        return true;
+#else
+        (void)data, (void)pages, (void)pageSize, (void)written;
+        return false;
+#endif
+    }
+}
+#endif
+
 bool io::exists(const std::string& name)
 {
     struct stat buffer;
     return (stat(name.c_str(), &buffer) == 0);
 }
+
+#ifdef _PKSMCORE_ENABLE_MMAP
+std::shared_ptr<u8[]> io::mapFile(const std::string& name, size_t& length)
+{
+    int fd = open(name.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        return nullptr;
+    }
+    struct stat buffer;
+    if (fstat(fd, &buffer) != 0 || buffer.st_size == 0)
+    {
+        close(fd);
+        return nullptr;
+    }
+    size_t size = buffer.st_size;
+    void* map   = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    // The mapping stays valid after the descriptor is closed
+    close(fd);
+    if (map == MAP_FAILED)
+    {
+        return nullptr;
+    }
+    length = size;
+    return std::shared_ptr<u8[]>(static_cast<u8*>(map), [size](u8* p) { munmap(p, size); });
+}
+
+bool io::writeChanged(const std::string& name, const u8* data, size_t length, bool mapped)
+{
+    int fd = open(name.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    struct stat buffer;
+    if (fstat(fd, &buffer) != 0)
+    {
+        close(fd);
+        return false;
+    }
+    // The page table only says what changed relative to the file as it was loaded
+    const bool sameSize   = size_t(buffer.st_size) == length;
+    const size_t pageSize = sysconf(_SC_PAGESIZE);
+    const size_t pages    = (length + pageSize - 1) / pageSize;
+    std::vector<bool> written;
+    bool knowWritten = mapped && sameSize && writtenPages(data, pages, pageSize, written);
+
+    std::vector<u8> onDisk(pageSize);
+    bool ok          = true;
+    size_t runStart  = 0;
+    size_t runLength = 0;
+    for (size_t page = 0; page <= pages && ok; page++)
+    {
+        size_t offset = page * pageSize;
+        size_t size   = page < pages ? std::min(pageSize, length - offset) : 0;
+        bool dirty    = false;
+        if (size != 0)
+        {
+            if (knowWritten)
+            {
+                dirty = written[page];
+            }
+            else
+            {
+                dirty = pread(fd, onDisk.data(), size, offset) != ssize_t(size) ||
+                        std::memcmp(onDisk.data(), data + offset, size) != 0;
+            }
+        }
+
+        // Neighbouring dirty pages go out in one write
+        if (dirty)
+        {
+            if (runLength == 0)
+            {
+                runStart = offset;
+            }
+            runLength += size;
+        }
+        else if (runLength != 0)
+        {
+            ok        = pwrite(fd, data + runStart, runLength, runStart) == ssize_t(runLength);
+            runLength = 0;
+        }
+    }
+
+    if (ok && !sameSize)
+    {
+        // Drop anything past the end of the save left over from a longer file
+        ok = ftruncate(fd, length) == 0;
+    }
+    return close(fd) == 0 && ok;
+}
+
+bool io::sameFile(const std::string& a, const std::string& b)
+{
+    struct stat first, second;
+    return stat(a.c_str(), &first) == 0 && stat(b.c_str(), &second) == 0 &&
+           first.st_dev == second.st_dev && first.st_ino == second.st_ino;
+}
+#endif
@@ -911,6 +911,26 @@ namespace pksm::internal
          {pksm::Move::Stockpile, 10}, {pksm::Move::RockTomb, 10}, {pksm::Move::Extrasensory, 30},
          {pksm::Move::Covet, 40}}
     };
+
+    // PP_G8 with a generation's differences applied. Earlier entries win, as they did when the
+    // lists were searched
+    template <size_t N>
+    constexpr std::array<u8, PP_G8.size()> applyPPDiff(
+        const std::array<std::pair<pksm::Move, u8>, N>& diff)
+    {
+        std::array<u8, PP_G8.size()> ret = PP_G8;
+        for (size_t i = N; i > 0; i--)
+        {
+            ret[size_t(diff[i - 1].first)] = diff[i - 1].second;
+        }
+        return ret;
+    }
+
+    constexpr std::array<u8, PP_G8.size()> PP_LGPE = applyPPDiff(PPDiff_LGPE);
+    constexpr std::array<u8, PP_G8.size()> PP_G6   = applyPPDiff(PPDiff_G6);
+    constexpr std::array<u8, PP_G8.size()> PP_G5   = applyPPDiff(PPDiff_G5);
+    constexpr std::array<u8, PP_G8.size()> PP_G4   = applyPPDiff(PPDiff_G4);
+    constexpr std::array<u8, PP_G8.size()> PP_G123 = applyPPDiff(PPDiff_G123);
 }
 
 #endif
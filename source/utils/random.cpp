@@ -76,3 +76,22 @@ void pksm::seedRand(std::seed_seq& seed)
     randomNumbers.seed(seed);
     seeded = true;
 }
+
+struct pksm::RandomStateGuard::State
+{
+    pcg32 randomNumbers;
+    std::uniform_int_distribution<u32> distrib;
+    bool seeded;
+};
+
+pksm::RandomStateGuard::RandomStateGuard()
+    : saved(new State{randomNumbers, distrib, seeded})
+{
+}
+
+pksm::RandomStateGuard::~RandomStateGuard()
+{
+    randomNumbers = saved->randomNumbers;
+    distrib       = saved->distrib;
+    seeded        = saved->seeded;
+}
@@ -0,0 +1,227 @@
+/*
+ *   This file is part of PKSM-Core
+ *   Copyright (C) 2016-2022 Bernardo Giordano, Admiral Fish, piepie62
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+ *       * Requiring preservation of specified reasonable legal notices or
+ *         author attributions in that material or in the Appropriate Legal
+ *         Notices displayed by works containing it.
+ *       * Prohibiting misrepresentation of the origin of that material,
+ *         or requiring that modified versions of such material be marked in
+ *         reasonable ways as different from the original version.
+ */
+
+// Checks CloneDetector against comparing every pair of Pokemon across a few saves, some of them
+// planted as exact copies, copies in the party, and copies that were changed afterwards
+
+#include "common.hpp"
+#include "pkx/PB7.hpp"
+#include "pkx/PK3.hpp"
+#include "pkx/PK8.hpp"
+#include "sav/CloneDetector.hpp"
+#include <algorithm>
+#include <tuple>
+
+namespace
+{
+    using Record  = std::tuple<u32, u8, u8>;
+    using Cluster = std::pair<bool, std::vector<Record>>;
+
+    struct Found
+    {
+        Record record;
+        std::unique_ptr<pksm::PKX> pk;
+    };
+
+    // The part of a record a box slot keeps
+    std::span<const u8> stored(const pksm::PKX& pk)
+    {
+        switch (pk.generation())
+        {
+            case pksm::Generation::THREE:
+                return pk.rawData().subspan(0, pksm::PK3::BOX_LENGTH);
+            case pksm::Generation::LGPE:
+                return pk.rawData().subspan(0, pksm::PB7::BOX_LENGTH);
+            case pksm::Generation::EIGHT:
+                return pk.rawData().subspan(0, pksm::PK8::BOX_LENGTH);
+            default:
+                return pk.rawData();
+        }
+    }
+
+    bool sameBytes(const pksm::PKX& a, const pksm::PKX& b)
+    {
+        return a.generation() == b.generation() && std::ranges::equal(stored(a), stored(b));
+    }
+
+    bool sameIndividual(const pksm::PKX& a, const pksm::PKX& b)
+    {
+        if (a.generation() != b.generation())
+        {
+            return false;
+        }
+        if (a.generation() < pksm::Generation::THREE)
+        {
+            return sameBytes(a, b);
+        }
+        return a.encryptionConstant() == b.encryptionConstant() && a.PID() == b.PID() &&
+               a.TID() == b.TID() && a.SID() == b.SID();
+    }
+
+    // Groups found by comparing every pair, in the order clusters() promises: by the first record
+    // in each, exact groups before the individual they belong to
+    std::vector<Cluster> expected(const std::vector<Found>& all)
+    {
+        std::vector<Cluster> ret;
+        std::vector<bool> grouped(all.size()), exactGrouped(all.size());
+        for (size_t i = 0; i < all.size(); i++)
+        {
+            if (!exactGrouped[i])
+            {
+                Cluster exact{true, {}};
+                for (size_t j = i; j < all.size(); j++)
+                {
+                    if (sameBytes(*all[i].pk, *all[j].pk))
+                    {
+                        exact.second.push_back(all[j].record);
+                        exactGrouped[j] = true;
+                    }
+                }
+                if (exact.second.size() > 1)
+                {
+                    ret.push_back(exact);
+                }
+            }
+            if (!grouped[i])
+            {
+                Cluster individual{false, {}};
+                bool differs = false;
+                for (size_t j = i; j < all.size(); j++)
+                {
+                    if (sameIndividual(*all[i].pk, *all[j].pk))
+                    {
+                        individual.second.push_back(all[j].record);
+                        differs |= !sameBytes(*all[i].pk, *all[j].pk);
+                        grouped[j] = true;
+                    }
+                }
+                if (differs)
+                {
+                    ret.push_back(individual);
+                }
+            }
+        }
+        return ret;
+    }
+
+    std::vector<Cluster> flatten(const std::vector<pksm::CloneDetector::Cluster>& clusters)
+    {
+        std::vector<Cluster> ret;
+        for (const auto& cluster : clusters)
+        {
+            Cluster& flat = ret.emplace_back(cluster.exact, std::vector<Record>{});
+            for (const auto& record : cluster.records)
+            {
+                flat.second.emplace_back(record.save, record.where.box, record.where.slot);
+            }
+        }
+        return ret;
+    }
+
+    // Puts the Pokemon from (box, slot) somewhere else in to, optionally after changing it
+    void plant(const pksm::Sav& from, u8 box, u8 slot, pksm::Sav& to, u8 toBox, u8 toSlot,
+        bool change = false)
+    {
+        auto pk = from.pkm(box, slot);
+        if (change)
+        {
+            pk->level(pk->level() == 100 ? 99 : pk->level() + 1);
+            pk->refreshChecksum();
+        }
+        to.pkm(*pk, toBox, toSlot, false);
+    }
+}
+
+int main()
+{
+    auto gen1  = test::blankSave(0x8000);
+    auto gen3  = test::blankGen3();
+    auto lgpe  = test::blankSave(0xB8800);
+    auto swshA = test::blankSWSH();
+    auto swshB = test::blankSWSH();
+    lgpe->version(pksm::GameVersion::GP);
+    test::fillBoxes(*gen1, 1, true);
+    test::fillBoxes(*gen3, 3);
+    test::fillBoxes(*lgpe, 7);
+    test::fillBoxes(*swshA, 8);
+    test::fillBoxes(*swshB, 9);
+
+    // Copies within a box, across boxes and into the party
+    plant(*gen1, 0, 0, *gen1, 0, 1);
+    plant(*gen1, 1, 0, *gen1, 11, 19);
+    gen1->pkm(*gen1->pkm(2, 0), 0);
+    gen1->partyCount(1);
+    plant(*gen3, 0, 0, *gen3, 1, 0);
+    plant(*gen3, 0, 0, *gen3, 2, 0, true);
+    plant(*gen3, 0, 1, *gen3, 13, 29, true);
+    plant(*lgpe, 0, 0, *lgpe, 33, 9);
+    // Across saves, with a changed copy of the same Pokemon in both
+    plant(*swshA, 0, 0, *swshB, 3, 3);
+    plant(*swshA, 0, 0, *swshA, 5, 0, true);
+    plant(*swshA, 0, 0, *swshB, 31, 29, true);
+    swshA->pkm(*swshA->pkm(0, 2), 0);
+    swshA->pkm(*swshA->pkm(0, 2), 1);
+    swshA->partyCount(2);
+    // Another exact copy, in a save that has changed ones too
+    plant(*gen3, 4, 4, *gen3, 4, 5);
+
+    const std::vector<std::pair<u32, const pksm::Sav*>> saves = {
+        {10, gen1.get()}, {30, gen3.get()}, {70, lgpe.get()}, {80, swshA.get()}, {81, swshB.get()}};
+
+    std::vector<Found> all;
+    pksm::CloneDetector added;
+    for (const auto& [id, sav] : saves)
+    {
+        for (test::Slot& slot : test::readSlots(*sav))
+        {
+            all.push_back({{id, slot.where.box, slot.where.slot}, std::move(slot.pk)});
+        }
+        added.add(id, *sav);
+    }
+
+    const std::vector<Cluster> want = expected(all);
+    const size_t exact = std::ranges::count_if(want, [](const Cluster& c) { return c.first; });
+    CHECK(exact >= 6);
+    CHECK(want.size() - exact >= 3);
+    CHECK(added.size() == all.size());
+    CHECK(flatten(added.clusters()) == want);
+
+    // Scanning the saves in parallel, or merging detectors run over separate saves, finds the same
+    const pksm::CloneDetector scanned = pksm::CloneDetector::scan(saves);
+    CHECK(flatten(scanned.clusters()) == want);
+    pksm::CloneDetector first, second;
+    for (size_t i = 0; i < saves.size(); i++)
+    {
+        (i < 2 ? first : second).add(saves[i].first, *saves[i].second);
+    }
+    first.merge(std::move(second));
+    CHECK(second.size() == 0);
+    CHECK(flatten(first.clusters()) == want);
+
+    std::printf("  %zu Pokemon, %zu exact and %zu changed clusters\n", all.size(), exact,
+        want.size() - exact);
+    return test::finish("clone_detector");
+}
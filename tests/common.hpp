@@ -0,0 +1,269 @@
+/*
+ *   This file is part of PKSM-Core
+ *   Copyright (C) 2016-2022 Bernardo Giordano, Admiral Fish, piepie62
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+ *       * Requiring preservation of specified reasonable legal notices or
+ *         author attributions in that material or in the Appropriate Legal
+ *         Notices displayed by works containing it.
+ *       * Prohibiting misrepresentation of the origin of that material,
+ *         or requiring that modified versions of such material be marked in
+ *         reasonable ways as different from the original version.
+ */
+
+#ifndef TESTS_COMMON_HPP
+#define TESTS_COMMON_HPP
+
+#include "pkx/PKX.hpp"
+#include "sav/Sav.hpp"
+#include "utils/crypto.hpp"
+#include "utils/endian.hpp"
+#include "utils/random.hpp"
+#include <bit>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+
+// Checks report every failure and carry on; finish() turns the count into the exit status
+#define CHECK(cond)                                                                                \
+    do                                                                                             \
+    {                                                                                              \
+        if (!(cond))                                                                               \
+        {                                                                                          \
+            std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);          \
+            ++test::failures;                                                                      \
+        }                                                                                          \
+    }                                                                                              \
+    while (false)
+
+namespace test
+{
+    inline int failures = 0;
+
+    inline int finish(const char* name)
+    {
+        if (failures == 0)
+        {
+            std::printf("%s: ok\n", name);
+            return 0;
+        }
+        std::printf("%s: %d checks failed\n", name, failures);
+        return 1;
+    }
+
+    // Loads a zero-filled save of the given length, which is enough for the formats that don't
+    // validate their contents on load
+    inline std::unique_ptr<pksm::Sav> blankSave(size_t length)
+    {
+        return pksm::Sav::getSave(std::shared_ptr<u8[]>(new u8[length]{}), length);
+    }
+
+    // Gen III saves find their sections by the IDs in each section's footer, so the active save
+    // gets its fourteen sections numbered in order and a save index higher than the backup's
+    inline std::unique_ptr<pksm::Sav> blankGen3(void)
+    {
+        static constexpr size_t length = 0x20000;
+        std::shared_ptr<u8[]> data(new u8[length]{});
+        for (int i = 0; i < 14; i++)
+        {
+            LittleEndian::convertFrom<u16>(&data[i * 0x1000 + 0xFF4], i);
+            LittleEndian::convertFrom<u32>(&data[i * 0x1000 + 0xFFC], 1);
+        }
+        return pksm::Sav::getSave(data, length);
+    }
+
+    // SwSh saves are a list of encrypted blocks that must all be present, so this builds one with
+    // every block the library reads, zero-filled, and one last block filling the rest of the file
+    inline std::unique_ptr<pksm::Sav> blankSWSH(void)
+    {
+        static constexpr size_t length = 0x1716B3;
+        // Sorted by key, as the save looks them up by binary search
+        static constexpr std::pair<u32, u32> blocks[] = {
+            {0x017C3CBB, 0x100          }, // Current box
+            {0x0d66012c, 0x158 * 30 * 32}, // Box
+            {0x112d5141, 0x10000        }, // WondercardData
+            {0x1177c2c4, 0x2000         }, // Items
+            {0x19722c89, 0x1000         }, // BoxLayout
+            {0x1b882b09, 0x1000         }, // Misc
+            {0x2985fe5d, 0x1000         }, // Party
+            {0x2EB1B190, 0x100          }, // Box wallpapers
+            {0x3C9366F0, 0x8000         }, // CrownDex
+            {0x3F936BA9, 0x8000         }, // ArmorDex
+            {0x4716c404, 0x8000         }, // PokeDex
+            {0x874da6fa, 0x1000         }, // TrainerCard
+            {0x8cbbfd90, 0x100          }, // PlayTime
+            {0xf25c070e, 0x1000         }, // Status
+        };
+
+        struct XorShift32
+        {
+            u32 seed;
+            u32 counter = 0;
+
+            static void advance(u32& key)
+            {
+                key ^= key << 2;
+                key ^= key >> 15;
+                key ^= key << 13;
+            }
+
+            explicit XorShift32(u32 key) : seed(key)
+            {
+                for (int i = std::popcount(key); i > 0; i--)
+                {
+                    advance(seed);
+                }
+            }
+
+            u8 next()
+            {
+                u8 ret = seed >> (counter * 8);
+                if (++counter == 4)
+                {
+                    advance(seed);
+                    counter = 0;
+                }
+                return ret;
+            }
+        };
+
+        using Type = pksm::crypto::swsh::SCBlock::SCBlockType;
+        std::shared_ptr<u8[]> data(new u8[length]{});
+        size_t offset = 0;
+        auto put      = [&](u32 key, u32 size)
+        {
+            XorShift32 xorShift(key);
+            LittleEndian::convertFrom<u32>(&data[offset], key);
+            // Object block: type, then length, then the data, all encrypted
+            data[offset + 4] = u8(Type::Object) ^ xorShift.next();
+            for (int i = 0; i < 4; i++)
+            {
+                data[offset + 5 + i] = u8(size >> (i * 8)) ^ xorShift.next();
+            }
+            for (size_t i = 0; i < size; i++)
+            {
+                data[offset + 9 + i] = xorShift.next();
+            }
+            offset += 9 + size;
+        };
+        for (const auto& [key, size] : blocks)
+        {
+            put(key, size);
+        }
+        put(0xFFFFFFFF, length - 32 - offset - 9);
+        pksm::crypto::swsh::applyXor(data, length);
+
+        auto sav = pksm::Sav::getSave(data, length);
+        sav->version(pksm::GameVersion::SW);
+        return sav;
+    }
+
+    // Every box slot the save has. Gen I and II boxes are lists of maxSlot() / maxBoxes()
+    // Pokemon, and everything else is numbered box * 30 + slot up to maxSlot()
+    inline std::vector<pksm::Sav::StorageSlot> boxSlots(const pksm::Sav& sav)
+    {
+        const bool lists = sav.generation() == pksm::Generation::ONE ||
+                           sav.generation() == pksm::Generation::TWO;
+        const int perBox = lists ? sav.maxSlot() / sav.maxBoxes() : 30;
+        std::vector<pksm::Sav::StorageSlot> ret;
+        for (int box = 0; box < sav.maxBoxes(); box++)
+        {
+            for (int slot = 0; slot < perBox && (lists || box * 30 + slot < sav.maxSlot()); slot++)
+            {
+                ret.push_back({u8(box), u8(slot)});
+            }
+        }
+        return ret;
+    }
+
+    struct Slot
+    {
+        pksm::Sav::StorageSlot where;
+        std::unique_ptr<pksm::PKX> pk;
+    };
+
+    // Every occupied party slot, then every occupied box slot, read one at a time with pkm().
+    // LGPE party members are box slots, so they are only read as such
+    inline std::vector<Slot> readSlots(const pksm::Sav& sav)
+    {
+        std::vector<Slot> ret;
+        if (sav.generation() != pksm::Generation::LGPE)
+        {
+            for (u8 slot = 0; slot < sav.partyCount(); slot++)
+            {
+                ret.push_back({{pksm::Sav::StorageSlot::PARTY, slot}, sav.pkm(slot)});
+            }
+        }
+        for (pksm::Sav::StorageSlot where : boxSlots(sav))
+        {
+            ret.push_back({where, sav.pkm(where.box, where.slot)});
+        }
+        std::erase_if(
+            ret, [](const Slot& slot) { return slot.pk->species() == pksm::Species::None; });
+        return ret;
+    }
+
+    // Puts a random Pokemon in roughly three quarters of the box slots, or all of them if full is
+    // set, drawing species, forms, items, abilities and moves from what the save's game has. The
+    // same seed gives the same PC
+    inline void fillBoxes(pksm::Sav& sav, u32 seed, bool full = false)
+    {
+        std::mt19937 rng(seed);
+        // Setters that have to pick a new PID, like Gen III natures, use the library's generator
+        pksm::seedRand(seed);
+        const std::vector<pksm::Species> species(
+            sav.availableSpecies().begin(), sav.availableSpecies().end());
+        const std::vector<int> items(sav.availableItems().begin(), sav.availableItems().end());
+        const std::vector<pksm::Move> moves(
+            sav.availableMoves().begin(), sav.availableMoves().end());
+        auto pick = [&rng](const auto& from) { return from[rng() % from.size()]; };
+
+        for (pksm::Sav::StorageSlot where : boxSlots(sav))
+        {
+            if (rng() % 4 == 0 && !full)
+            {
+                continue;
+            }
+            auto pk = sav.emptyPkm();
+            pk->species(pick(species));
+            pk->alternativeForm(rng() % std::max<u8>(1, sav.formCount(pk->species())));
+            pk->PID(rng());
+            pk->encryptionConstant(rng());
+            pk->TID(rng() % 4);
+            pk->SID(rng() % 4);
+            pk->version(sav.version());
+            pk->language(pksm::Language::ENG);
+            pk->nature(pksm::Nature{u8(rng() % 25)});
+            pk->setAbility(rng() % 3);
+            if (!items.empty() && rng() % 2 == 0)
+            {
+                pk->heldItem(u16(pick(items)));
+            }
+            for (u8 i = 0; i < 4; i++)
+            {
+                pk->move(i, pick(moves));
+            }
+            pk->level(1 + rng() % 100);
+            pk->egg(rng() % 16 == 0);
+            pk->healPP();
+            pk->refreshChecksum();
+            sav.pkm(*pk, where.box, where.slot, false);
+        }
+    }
+}
+
+#endif
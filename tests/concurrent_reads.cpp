@@ -0,0 +1,169 @@
+/*
+ *   This file is part of PKSM-Core
+ *   Copyright (C) 2016-2022 Bernardo Giordano, Admiral Fish, piepie62
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+ *       * Requiring preservation of specified reasonable legal notices or
+ *         author attributions in that material or in the Appropriate Legal
+ *         Notices displayed by works containing it.
+ *       * Prohibiting misrepresentation of the origin of that material,
+ *         or requiring that modified versions of such material be marked in
+ *         reasonable ways as different from the original version.
+ */
+
+// Runs const members of several kinds of save from many threads at once and checks that every
+// thread sees what a single thread sees. Run it with `make tsan` to have ThreadSanitizer look for
+// writes hiding behind const members, like block decryption or cached slot decoding
+
+#include "common.hpp"
+#include "pkx/PKFilter.hpp"
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <thread>
+
+namespace
+{
+    constexpr int THREADS = 8;
+
+    struct Reads
+    {
+        u64 visited = 0;
+        u64 slots   = 0;
+        std::vector<u64> found;
+        int seen   = 0;
+        int caught = 0;
+        std::vector<u32> diffBlocks;
+        size_t diffPkm = 0;
+        std::vector<int> free;
+
+        bool operator==(const Reads&) const = default;
+    };
+
+    Reads readAll(const pksm::Sav& sav, const pksm::Sav& changed, size_t threads)
+    {
+        Reads ret;
+        std::atomic<u64> visited = 0;
+        sav.forEachPKM(
+            [&visited](const pksm::PKX& pk, pksm::Sav::StorageSlot where)
+            { visited += u64(pk.species()) * (where.box * 30 + where.slot + 1); },
+            threads);
+        ret.visited = visited;
+
+        for (int box = 0; box < sav.maxBoxes(); box++)
+        {
+            for (int slot = 0; slot < 30; slot++)
+            {
+                auto pk = sav.pkm(box, slot);
+                ret.slots += u64(pk->species()) ^ pk->PID();
+            }
+        }
+
+        pksm::PKFilter filter;
+        filter.speciesIn(pksm::Species::Pikachu, true);
+        filter.speciesIn(pksm::Species::Eevee, true);
+        filter.levelRange(1, 50);
+        filter.levelRangeEnabled(true);
+        ret.found = sav.findPKM(filter, threads);
+
+        ret.seen   = sav.dexSeen();
+        ret.caught = sav.dexCaught();
+
+        pksm::Sav::Diff diff = pksm::diffSaves(sav, changed);
+        ret.diffBlocks       = diff.blocks;
+        ret.diffPkm          = diff.pkm.size();
+
+        ret.free = sav.freeSlots();
+        return ret;
+    }
+
+    // Ending an edit and starting another leaves SwSh blocks encrypted until something reads them
+    void encryptBlocks(pksm::Sav& sav)
+    {
+        sav.finishEditing();
+        sav.beginEditing();
+    }
+
+    void check(const char* name, const std::function<std::unique_ptr<pksm::Sav>()>& make,
+        bool lazyDecryption = false)
+    {
+        auto sav     = make();
+        auto changed = make();
+        CHECK(sav && changed);
+        if (!sav || !changed)
+        {
+            return;
+        }
+        test::fillBoxes(*sav, 1);
+        test::fillBoxes(*changed, 1);
+        auto moved = changed->pkm(0, 0);
+        changed->pkm(*changed->emptyPkm(), 0, 0, false);
+        changed->pkm(*moved, 1, 29, false);
+        const pksm::Species dexed[] = {pksm::Species::Pikachu, pksm::Species::Eevee};
+        for (pksm::Species species : dexed)
+        {
+            auto pk = sav->emptyPkm();
+            pk->species(species);
+            pk->level(5);
+            sav->dex(*pk);
+        }
+        // The occupancy index is the one thing that has to be built before sharing the save
+        (void)sav->firstFreeSlot();
+        (void)changed->firstFreeSlot();
+
+        const Reads expected = readAll(*sav, *changed, 1);
+        if (lazyDecryption)
+        {
+            // Start over from encrypted blocks so that the threads race to decrypt them
+            encryptBlocks(*sav);
+            encryptBlocks(*changed);
+            (void)sav->firstFreeSlot();
+            (void)changed->firstFreeSlot();
+        }
+
+        std::vector<Reads> got(THREADS);
+        std::vector<std::thread> threads;
+        for (int i = 0; i < THREADS; i++)
+        {
+            threads.emplace_back([&, i] { got[i] = readAll(*sav, *changed, 1 + i % 4); });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        const auto agree = std::count(got.begin(), got.end(), expected);
+        CHECK(agree == THREADS);
+        CHECK(expected.visited != 0);
+        CHECK(expected.diffPkm != 0);
+        std::printf("  %s: %d of %d threads agree\n", name, int(agree), THREADS);
+    }
+}
+
+int main()
+{
+    check("Gen I", [] { return test::blankSave(0x8000); });
+    check("Gen III", test::blankGen3);
+    check("LGPE",
+        []
+        {
+            auto sav = test::blankSave(0xB8800);
+            sav->version(pksm::GameVersion::GP);
+            return sav;
+        });
+    check("SwSh", test::blankSWSH, true);
+    return test::finish("concurrent_reads");
+}
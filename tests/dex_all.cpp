@@ -0,0 +1,120 @@
+/*
+ *   This file is part of PKSM-Core
+ *   Copyright (C) 2016-2022 Bernardo Giordano, Admiral Fish, piepie62
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+ *       * Requiring preservation of specified reasonable legal notices or
+ *         author attributions in that material or in the Appropriate Legal
+ *         Notices displayed by works containing it.
+ *       * Prohibiting misrepresentation of the origin of that material,
+ *         or requiring that modified versions of such material be marked in
+ *         reasonable ways as different from the original version.
+ */
+
+// Checks that Sav::dexAll leaves the same Pokedex flags and counts as calling Sav::dex on every
+// Pokemon in the party and boxes that isn't an egg, for each kind of save the library can load
+// from scratch
+
+#include "common.hpp"
+#include <algorithm>
+#include <functional>
+
+namespace
+{
+    // A Gen VI or VII save has to know its game before it knows which species it has
+    std::function<std::unique_ptr<pksm::Sav>()> blank(size_t length, pksm::GameVersion version)
+    {
+        return [=]
+        {
+            auto sav = test::blankSave(length);
+            sav->version(version);
+            return sav;
+        };
+    }
+
+    // The first few boxed Pokemon go in the party too, so that some are seen twice
+    void fill(pksm::Sav& sav)
+    {
+        test::fillBoxes(sav, 40);
+        for (u8 slot = 0; slot < 3; slot++)
+        {
+            sav.pkm(*sav.pkm(0, slot), slot);
+        }
+        sav.partyCount(3);
+    }
+
+    void check(const char* name, const std::function<std::unique_ptr<pksm::Sav>()>& make)
+    {
+        auto all  = make();
+        auto each = make();
+        fill(*all);
+        fill(*each);
+        // Counted up front, so that dexAll has to forget the counts and dex has to keep them
+        // current
+        (void)all->dexSeen();
+        (void)all->dexCaught();
+        (void)each->dexSeen();
+        (void)each->dexCaught();
+
+        all->dexAll();
+
+        std::vector<std::unique_ptr<pksm::PKX>> pks;
+        each->forEachPKM([&pks](const pksm::PKX& pk, pksm::Sav::StorageSlot)
+            { pks.push_back(pk.clone()); });
+        for (const auto& pk : pks)
+        {
+            if (!pk->egg())
+            {
+                each->dex(*pk);
+            }
+        }
+
+        const int seen   = all->dexSeen();
+        const int caught = all->dexCaught();
+        CHECK(caught > 0);
+        CHECK(seen == each->dexSeen());
+        CHECK(caught == each->dexCaught());
+
+        // Every flag, in the form the game reads it
+        all->finishEditing();
+        each->finishEditing();
+        CHECK(all->getLength() == each->getLength());
+        CHECK(std::equal(all->rawData().get(), all->rawData().get() + all->getLength(),
+            each->rawData().get()));
+
+        // And the counts dexAll left behind match a count from nothing
+        std::shared_ptr<u8[]> copy(new u8[all->getLength()]);
+        std::copy_n(all->rawData().get(), all->getLength(), copy.get());
+        auto reloaded = pksm::Sav::getSave(copy, all->getLength());
+        CHECK(reloaded && reloaded->dexSeen() == seen && reloaded->dexCaught() == caught);
+
+        std::printf("  %s: %zu Pokemon, %d seen, %d caught\n", name, pks.size(), seen, caught);
+    }
+}
+
+int main()
+{
+    check("Gen I", [] { return test::blankSave(0x8000); });
+    check("Gen III", test::blankGen3);
+    check("XY", blank(0x65600, pksm::GameVersion::X));
+    check("ORAS", blank(0x76000, pksm::GameVersion::OR));
+    check("SM", blank(0x6BE00, pksm::GameVersion::SN));
+    check("USUM", blank(0x6CC00, pksm::GameVersion::US));
+    check("LGPE", blank(0xB8800, pksm::GameVersion::GP));
+    check("SwSh", test::blankSWSH);
+
+    return test::finish("dex_all");
+}
@@ -0,0 +1,180 @@
+/*
+ *   This file is part of PKSM-Core
+ *   Copyright (C) 2016-2022 Bernardo Giordano, Admiral Fish, piepie62
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+ *       * Requiring preservation of specified reasonable legal notices or
+ *         author attributions in that material or in the Appropriate Legal
+ *         Notices displayed by works containing it.
+ *       * Prohibiting misrepresentation of the origin of that material,
+ *         or requiring that modified versions of such material be marked in
+ *         reasonable ways as different from the original version.
+ */
+
+// Times typical PKFilter searches over a full SwSh and a full LGPE PC: testing each Pokemon with
+// PKX::operator==, testing them with a CompiledPKFilter, and Sav::findPKM on one and four threads,
+// which also reads the records out of the save. Every way has to find the same Pokemon. The PCs
+// come from a fixed seed, so runs on the same machine are comparable
+
+#include "common.hpp"
+#include "pkx/PKFilter.hpp"
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <functional>
+#include <numeric>
+
+namespace
+{
+    constexpr int RUNS = 51;
+
+    struct Case
+    {
+        const char* name;
+        std::function<void(pksm::PKFilter&)> setup;
+    };
+
+    const Case cases[] = {
+        {"one species",
+         [](pksm::PKFilter& f)
+         {
+             f.species(pksm::Species::Pikachu);
+             f.speciesEnabled(true);
+         }},
+        {"species set (8)",
+         [](pksm::PKFilter& f)
+         {
+             const pksm::Species set[] = {pksm::Species::Pikachu, pksm::Species::Eevee,
+                 pksm::Species::Charizard, pksm::Species::Gengar, pksm::Species::Snorlax,
+                 pksm::Species::Dragonite, pksm::Species::Mewtwo, pksm::Species::Mew};
+             for (const pksm::Species& s : set)
+             {
+                 f.speciesIn(s, true);
+             }
+         }},
+        {"knows a move",
+         [](pksm::PKFilter& f)
+         {
+             f.moveIn(pksm::Move::Earthquake, true);
+             f.moveIn(pksm::Move::Surf, true);
+         }},
+        {"nature + level 50-100",
+         [](pksm::PKFilter& f)
+         {
+             f.nature(pksm::Nature::Adamant);
+             f.natureEnabled(true);
+             f.levelRange(50, 100);
+             f.levelRangeEnabled(true);
+         }},
+        {"shiny, not egg",
+         [](pksm::PKFilter& f)
+         {
+             f.shiny(true);
+             f.shinyEnabled(true);
+             f.egg(false);
+             f.eggEnabled(true);
+         }},
+        {"species + ability + item",
+         [](pksm::PKFilter& f)
+         {
+             f.species(pksm::Species::Gengar);
+             f.speciesEnabled(true);
+             f.ability(pksm::Ability::CursedBody);
+             f.abilityEnabled(true);
+             f.heldItem(0);
+             f.heldItemEnabled(true);
+             f.heldItemInversed(true);
+         }},
+    };
+
+    // Median time of RUNS runs of work, in microseconds
+    double time(const std::function<void()>& work)
+    {
+        std::array<double, RUNS> runs;
+        for (double& run : runs)
+        {
+            auto start = std::chrono::steady_clock::now();
+            work();
+            run = std::chrono::duration<double, std::micro>(
+                std::chrono::steady_clock::now() - start)
+                      .count();
+        }
+        std::nth_element(runs.begin(), runs.begin() + RUNS / 2, runs.end());
+        return runs[RUNS / 2];
+    }
+
+    size_t countBits(const std::vector<u64>& bits)
+    {
+        return std::accumulate(bits.begin(), bits.end(), size_t(0),
+            [](size_t n, u64 word) { return n + std::popcount(word); });
+    }
+
+    void bench(const char* name, pksm::Sav& sav)
+    {
+        test::fillBoxes(sav, 41, true);
+        std::vector<std::unique_ptr<pksm::PKX>> pks;
+        for (int i = 0; i < sav.maxSlot(); i++)
+        {
+            pks.push_back(sav.pkm(i / 30, i % 30));
+        }
+
+        std::printf("%s, %zu Pokemon (median of %d runs, us)\n", name, pks.size(), RUNS);
+        std::printf("  %-26s %8s %10s %10s %10s %10s\n", "filter", "matches", "operator==",
+            "compiled", "findPKM", "findPKM x4");
+        for (const Case& c : cases)
+        {
+            pksm::PKFilter filter;
+            c.setup(filter);
+
+            size_t direct = 0, compiled = 0, found = 0, foundThreaded = 0;
+            const double directTime = time(
+                [&]
+                {
+                    direct = std::count_if(pks.begin(), pks.end(),
+                        [&](const std::unique_ptr<pksm::PKX>& pk) { return *pk == filter; });
+                });
+            const double compiledTime = time(
+                [&]
+                {
+                    const pksm::CompiledPKFilter compiledFilter(filter);
+                    compiled = std::count_if(pks.begin(), pks.end(),
+                        [&](const std::unique_ptr<pksm::PKX>& pk)
+                        { return compiledFilter.matches(*pk); });
+                });
+            const double findTime = time([&] { found = countBits(sav.findPKM(filter)); });
+            const double threadedTime =
+                time([&] { foundThreaded = countBits(sav.findPKM(filter, 4)); });
+
+            CHECK(direct == compiled);
+            CHECK(direct == found);
+            CHECK(direct == foundThreaded);
+            std::printf("  %-26s %8zu %10.1f %10.1f %10.1f %10.1f\n", c.name, direct, directTime,
+                compiledTime, findTime, threadedTime);
+        }
+    }
+}
+
+int main()
+{
+    auto swsh = test::blankSWSH();
+    bench("SwSh", *swsh);
+
+    auto lgpe = test::blankSave(0xB8800);
+    lgpe->version(pksm::GameVersion::GP);
+    bench("LGPE", *lgpe);
+
+    return test::finish("filter_bench");
+}
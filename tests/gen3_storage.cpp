@@ -0,0 +1,145 @@
+/*
+ *   This file is part of PKSM-Core
+ *   Copyright (C) 2016-2022 Bernardo Giordano, Admiral Fish, piepie62
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+ *       * Requiring preservation of specified reasonable legal notices or
+ *         author attributions in that material or in the Appropriate Legal
+ *         Notices displayed by works containing it.
+ *       * Prohibiting misrepresentation of the origin of that material,
+ *         or requiring that modified versions of such material be marked in
+ *         reasonable ways as different from the original version.
+ */
+
+// Checks that every Gen III PC edit reaches the save data straight away, so a copy of the data
+// loads as the same PC, and that PC records written through boxOffset survive finishEditing
+
+#include "common.hpp"
+#include "pkx/PK3.hpp"
+#include <algorithm>
+#include <array>
+
+namespace
+{
+    using Record = std::array<u8, pksm::PK3::BOX_LENGTH>;
+
+    // Where each byte of a box record lives in data, following boxOffset's note on records that
+    // are split between two sections
+    std::array<u32, pksm::PK3::BOX_LENGTH> recordBytes(const pksm::Sav& sav, u8 box, u8 slot)
+    {
+        const u32 offset = sav.boxOffset(box, slot);
+        const u32 first  = std::min<u32>(0xF80 - offset % 0x1000, pksm::PK3::BOX_LENGTH);
+        const u32 rest   = sav.boxOffset(box + (slot + 1) / 30, (slot + 1) % 30) & 0xFFFFF000;
+        std::array<u32, pksm::PK3::BOX_LENGTH> ret;
+        for (u32 i = 0; i < ret.size(); i++)
+        {
+            ret[i] = i < first ? offset + i : rest + i - first;
+        }
+        return ret;
+    }
+
+    Record fromData(const pksm::Sav& sav, u8 box, u8 slot)
+    {
+        Record ret;
+        const auto where = recordBytes(sav, box, slot);
+        for (size_t i = 0; i < ret.size(); i++)
+        {
+            ret[i] = sav.rawData()[where[i]];
+        }
+        return ret;
+    }
+
+    Record fromPkm(const pksm::Sav& sav, u8 box, u8 slot)
+    {
+        Record ret;
+        std::ranges::copy(sav.pkm(box, slot)->rawData(), ret.begin());
+        return ret;
+    }
+
+    // The save's data as it is right now, loaded as a save of its own
+    std::unique_ptr<pksm::Sav> reload(const pksm::Sav& sav)
+    {
+        std::shared_ptr<u8[]> copy(new u8[sav.getLength()]);
+        std::copy_n(sav.rawData().get(), sav.getLength(), copy.get());
+        return pksm::Sav::getSave(copy, sav.getLength());
+    }
+
+    size_t samePC(const pksm::Sav& a, const pksm::Sav& b)
+    {
+        size_t split = 0;
+        for (u8 box = 0; box < a.maxBoxes(); box++)
+        {
+            for (u8 slot = 0; slot < 30; slot++)
+            {
+                CHECK(fromData(a, box, slot) == fromPkm(a, box, slot));
+                CHECK(fromPkm(a, box, slot) == fromPkm(b, box, slot));
+                split += a.boxOffset(box, slot) % 0x1000 + pksm::PK3::BOX_LENGTH > 0xF80;
+            }
+            CHECK(a.boxName(box) == b.boxName(box));
+            CHECK(a.boxWallpaper(box) == b.boxWallpaper(box));
+        }
+        CHECK(a.currentBox() == b.currentBox());
+        return split;
+    }
+}
+
+int main()
+{
+    auto sav = test::blankGen3();
+    test::fillBoxes(*sav, 39);
+    for (u8 box = 0; box < sav->maxBoxes(); box++)
+    {
+        sav->boxName(box, "BOX " + std::to_string(box * 3));
+        sav->boxWallpaper(box, (box * 5) % 16);
+    }
+    sav->currentBox(5);
+    const size_t split = samePC(*sav, *reload(*sav));
+
+    // Edits in place and sorting
+    sav->editEachPKM(
+        [](pksm::PKX& pk, pksm::Sav::StorageSlot)
+        {
+            pk.nickname("EDITED");
+            return true;
+        });
+    samePC(*sav, *reload(*sav));
+    sav->sortBoxes(0, sav->maxBoxes() - 1, {{pksm::Sav::SortKey::Species}});
+    samePC(*sav, *reload(*sav));
+
+    // A record copied over another through boxOffset, split records included
+    size_t copied = 0;
+    for (u8 box = 0; box < sav->maxBoxes(); box++)
+    {
+        for (u8 slot = 0; slot + 1 < 30; slot += 2)
+        {
+            const Record record = fromData(*sav, box, slot);
+            const auto where    = recordBytes(*sav, box, slot + 1);
+            for (size_t i = 0; i < record.size(); i++)
+            {
+                sav->rawData()[where[i]] = record[i];
+            }
+            copied++;
+        }
+    }
+    auto before = reload(*sav);
+    sav->finishEditing();
+    samePC(*sav, *before);
+
+    std::printf("  %u boxes, %zu split records, %zu records copied through boxOffset\n",
+        unsigned(sav->maxBoxes()), split, copied);
+
+    return test::finish("gen3_storage");
+}
@@ -0,0 +1,150 @@
+/*
+ *   This file is part of PKSM-Core
+ *   Copyright (C) 2016-2022 Bernardo Giordano, Admiral Fish, piepie62
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+ *       * Requiring preservation of specified reasonable legal notices or
+ *         author attributions in that material or in the Appropriate Legal
+ *         Notices displayed by works containing it.
+ *       * Prohibiting misrepresentation of the origin of that material,
+ *         or requiring that modified versions of such material be marked in
+ *         reasonable ways as different from the original version.
+ */
+
+// Checks VersionTables::movePP against the linear search it replaced for every generation, move
+// and PP Up count, and that Sav::healPP restores exactly the boxes, and the party, it is asked to
+
+#include "common.hpp"
+#include "reference/movePP.hpp"
+#include "utils/VersionTables.hpp"
+#include <functional>
+
+namespace
+{
+    using Make = std::function<std::unique_ptr<pksm::Sav>()>;
+
+    Make blank(size_t length, pksm::GameVersion version)
+    {
+        return [=]
+        {
+            auto sav = test::blankSave(length);
+            sav->version(version);
+            return sav;
+        };
+    }
+
+    // Healed, and written back with a checksum that matches
+    bool healed(const pksm::PKX& pk)
+    {
+        auto refreshed = pk.clone();
+        refreshed->refreshChecksum();
+        if (refreshed->checksum() != pk.checksum())
+        {
+            return false;
+        }
+        for (u8 i = 0; i < 4; i++)
+        {
+            if (pk.PP(i) != pksm::reference::movePP(pk.generation(), pk.move(i), pk.PPUp(i)))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool drained(const pksm::PKX& pk)
+    {
+        return pk.PP(0) == 0 && pk.PP(1) == 0 && pk.PP(2) == 0 && pk.PP(3) == 0;
+    }
+
+    void checkHeal(const char* name, const Make& make, u32 seed)
+    {
+        auto sav = make();
+        test::fillBoxes(*sav, seed);
+        // A party made of the first few box Pokemon. LGPE party members are box slots already
+        if (sav->generation() != pksm::Generation::LGPE)
+        {
+            std::vector<test::Slot> slots = test::readSlots(*sav);
+            for (u8 slot = 0; slot < 3; slot++)
+            {
+                sav->pkm(*slots[slot].pk, slot);
+            }
+            sav->partyCount(3);
+        }
+        // Every move out of PP, with PP Ups from none to all three
+        sav->editEachPKM(
+            [seed = seed](pksm::PKX& pk, pksm::Sav::StorageSlot)
+            {
+                for (u8 i = 0; i < 4; i++)
+                {
+                    pk.PPUp(i, (seed + i + u16(pk.species())) % 4);
+                    pk.PP(i, 0);
+                }
+                return true;
+            });
+
+        sav->healPP(1, 2, false);
+        size_t inRange = 0;
+        for (const test::Slot& slot : test::readSlots(*sav))
+        {
+            const bool wanted = !slot.where.isParty() && slot.where.box >= 1 && slot.where.box <= 2;
+            CHECK(wanted ? healed(*slot.pk) : drained(*slot.pk));
+            inRange += wanted;
+        }
+        CHECK(inRange > 0);
+
+        sav->healPP(0, sav->maxBoxes() - 1, true);
+        size_t total = 0;
+        for (const test::Slot& slot : test::readSlots(*sav))
+        {
+            CHECK(healed(*slot.pk));
+            total++;
+        }
+
+        std::printf("  %s: %zu Pokemon, %zu in boxes 1 and 2\n", name, total, inRange);
+    }
+}
+
+int main()
+{
+    // Everything movePP takes, including a generation that has none and IDs past the last move
+    size_t compared = 0;
+    for (u32 gen : {0u, 1u, 2u, 3u, 4u, 5u, 6u, 7u, 8u, 0xFFFFFFFFu})
+    {
+        const pksm::Generation generation{gen};
+        for (u32 id = 0; id <= 1024; id++)
+        {
+            // One past the last ID stands for Move::INVALID
+            const pksm::Move move = id < 1024 ? pksm::Move{u16(id)} : pksm::Move{};
+            for (u8 ppUps = 0; ppUps < 4; ppUps++)
+            {
+                CHECK(pksm::VersionTables::movePP(generation, move, ppUps) ==
+                      pksm::reference::movePP(generation, move, ppUps));
+                compared++;
+            }
+        }
+    }
+    std::printf("  movePP: %zu lookups\n", compared);
+
+    checkHeal("Gen I", [] { return test::blankSave(0x8000); }, 1);
+    checkHeal("Gen III", test::blankGen3, 3);
+    checkHeal("XY", blank(0x65600, pksm::GameVersion::X), 6);
+    checkHeal("SM", blank(0x6BE00, pksm::GameVersion::SN), 7);
+    checkHeal("LGPE", blank(0xB8800, pksm::GameVersion::GP), 70);
+    checkHeal("SwSh", test::blankSWSH, 8);
+
+    return test::finish("move_pp");
+}
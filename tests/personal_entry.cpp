@@ -0,0 +1,146 @@
+/*
+ *   This file is part of PKSM-Core
+ *   Copyright (C) 2016-2022 Bernardo Giordano, Admiral Fish, piepie62
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+ *       * Requiring preservation of specified reasonable legal notices or
+ *         author attributions in that material or in the Appropriate Legal
+ *         Notices displayed by works containing it.
+ *       * Prohibiting misrepresentation of the origin of that material,
+ *         or requiring that modified versions of such material be marked in
+ *         reasonable ways as different from the original version.
+ */
+
+// Checks every generation's PersonalEntry, from entry() and from entries(), against the
+// per-field accessors for every record, and that entries() stops at the shorter of its spans
+
+#include "common.hpp"
+#include "personal/personal.hpp"
+#include <algorithm>
+#include <numeric>
+
+namespace
+{
+    struct Personal
+    {
+        const char* name;
+        u16 count;
+        pksm::PersonalEntry (*entry)(u16);
+        size_t (*entries)(std::span<const u16>, std::span<pksm::PersonalEntry>);
+        // The same record put together from the per-field accessors
+        pksm::PersonalEntry (*fields)(u16);
+    };
+
+// formStatIndex and the third ability are given for generations that lack them
+#define FIELDS(ns, formStatIndexOf, thirdAbility)                                                 \
+    [](u16 fs)                                                                                     \
+    {                                                                                              \
+        return pksm::PersonalEntry{.baseHP = pksm::ns::baseHP(fs),                                 \
+            .baseAtk                       = pksm::ns::baseAtk(fs),                                \
+            .baseDef                       = pksm::ns::baseDef(fs),                                \
+            .baseSpe                       = pksm::ns::baseSpe(fs),                                \
+            .baseSpa                       = pksm::ns::baseSpa(fs),                                \
+            .baseSpd                       = pksm::ns::baseSpd(fs),                                \
+            .type1                         = pksm::ns::type1(fs),                                  \
+            .type2                         = pksm::ns::type2(fs),                                  \
+            .gender                        = pksm::ns::gender(fs),                                 \
+            .baseFriendship                = pksm::ns::baseFriendship(fs),                         \
+            .expType                       = pksm::ns::expType(fs),                                \
+            .formCount                     = pksm::ns::formCount(fs),                              \
+            .formStatIndex                 = formStatIndexOf,                                      \
+            .abilities = {pksm::ns::ability(fs, 0), pksm::ns::ability(fs, 1), thirdAbility}};      \
+    }
+
+    bool same(const pksm::PersonalEntry& a, const pksm::PersonalEntry& b)
+    {
+        return a.baseHP == b.baseHP && a.baseAtk == b.baseAtk && a.baseDef == b.baseDef &&
+               a.baseSpe == b.baseSpe && a.baseSpa == b.baseSpa && a.baseSpd == b.baseSpd &&
+               a.type1 == b.type1 && a.type2 == b.type2 && a.gender == b.gender &&
+               a.baseFriendship == b.baseFriendship && a.expType == b.expType &&
+               a.formCount == b.formCount && a.formStatIndex == b.formStatIndex &&
+               a.abilities == b.abilities;
+    }
+
+    void check(const Personal& personal)
+    {
+        for (u16 fs = 0; fs < personal.count; fs++)
+        {
+            CHECK(same(personal.entry(fs), personal.fields(fs)));
+        }
+
+        // Every record, last first so that the order is the caller's and not the table's
+        std::vector<u16> formSpecies(personal.count);
+        std::iota(formSpecies.rbegin(), formSpecies.rend(), u16(0));
+
+        // A marker in every slot, to tell the ones entries() wrote from the ones it left alone
+        pksm::PersonalEntry marker{};
+        marker.baseHP        = 0xAB;
+        marker.formStatIndex = 0xABCD;
+        const auto decode    = [&](size_t fromCount, size_t outCount)
+        {
+            std::vector<pksm::PersonalEntry> out(outCount, marker);
+            const size_t decoded = personal.entries(
+                std::span(formSpecies).first(fromCount), std::span(out));
+            CHECK(decoded == std::min(fromCount, outCount));
+            for (size_t i = 0; i < out.size(); i++)
+            {
+                CHECK(same(out[i], i < decoded ? personal.fields(formSpecies[i]) : marker));
+            }
+        };
+        decode(personal.count, personal.count);
+        // Stops when the output runs out
+        decode(personal.count, personal.count / 2);
+        // Stops when the species run out, leaving the rest of the output alone
+        decode(personal.count / 3, personal.count);
+        decode(0, personal.count);
+        decode(personal.count, 0);
+
+        std::printf("  %s: %u records\n", personal.name, unsigned(personal.count));
+    }
+}
+
+int main()
+{
+    // Record counts are the size of each personal table over the size of one record
+    const Personal personals[] = {
+        {"RSFRLGE", 5031 / 13, pksm::PersonalRSFRLGE::entry, pksm::PersonalRSFRLGE::entries,
+            FIELDS(PersonalRSFRLGE, 0, pksm::Ability::None)},
+        {"DPPtHGSS", 8128 / 16, pksm::PersonalDPPtHGSS::entry, pksm::PersonalDPPtHGSS::entries,
+            FIELDS(PersonalDPPtHGSS, pksm::PersonalDPPtHGSS::formStatIndex(fs),
+                pksm::Ability::None)},
+        {"BWB2W2", 12053 / 17, pksm::PersonalBWB2W2::entry, pksm::PersonalBWB2W2::entries,
+            FIELDS(PersonalBWB2W2, pksm::PersonalBWB2W2::formStatIndex(fs),
+                pksm::PersonalBWB2W2::ability(fs, 2))},
+        {"XYORAS", 14042 / 17, pksm::PersonalXYORAS::entry, pksm::PersonalXYORAS::entries,
+            FIELDS(PersonalXYORAS, pksm::PersonalXYORAS::formStatIndex(fs),
+                pksm::PersonalXYORAS::ability(fs, 2))},
+        {"SMUSUM", 16592 / 17, pksm::PersonalSMUSUM::entry, pksm::PersonalSMUSUM::entries,
+            FIELDS(PersonalSMUSUM, pksm::PersonalSMUSUM::formStatIndex(fs),
+                pksm::PersonalSMUSUM::ability(fs, 2))},
+        {"LGPE", 16660 / 17, pksm::PersonalLGPE::entry, pksm::PersonalLGPE::entries,
+            FIELDS(PersonalLGPE, pksm::PersonalLGPE::formStatIndex(fs),
+                pksm::PersonalLGPE::ability(fs, 2))},
+        {"SWSH", 47680 / 40, pksm::PersonalSWSH::entry, pksm::PersonalSWSH::entries,
+            FIELDS(PersonalSWSH, pksm::PersonalSWSH::formStatIndex(fs),
+                pksm::PersonalSWSH::ability(fs, 2))},
+    };
+    for (const Personal& personal : personals)
+    {
+        check(personal);
+    }
+
+    return test::finish("personal_entry");
+}
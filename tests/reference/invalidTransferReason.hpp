@@ -0,0 +1,135 @@
+/*
+ *   This file is part of PKSM-Core
+ *   Copyright (C) 2016-2022 Bernardo Giordano, Admiral Fish, piepie62
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+ *       * Requiring preservation of specified reasonable legal notices or
+ *         author attributions in that material or in the Appropriate Legal
+ *         Notices displayed by works containing it.
+ *       * Prohibiting misrepresentation of the origin of that material,
+ *         or requiring that modified versions of such material be marked in
+ *         reasonable ways as different from the original version.
+ */
+
+#ifndef TESTS_REFERENCE_INVALIDTRANSFERREASON_HPP
+#define TESTS_REFERENCE_INVALIDTRANSFERREASON_HPP
+
+#include "pkx/PK1.hpp"
+#include "pkx/PK2.hpp"
+#include "pkx/PK3.hpp"
+#include "sav/Sav.hpp"
+#include "utils/ValueConverter.hpp"
+#include "utils/VersionTables.hpp"
+
+// Sav::invalidTransferReason as it was before TransferTable, copied from source/sav/Sav.cpp as it
+// was before commit 73278ec. The tables it used to take from a save are looked up from version
+
+namespace pksm::reference
+{
+    inline Sav::BadTransferReason invalidTransferReason(const PKX& pk, GameVersion version)
+    {
+        // What used to come from the save's TransferContext
+        const Generation generation = Generation(version);
+        const auto& moves           = VersionTables::moveTable(version);
+        const auto& species         = VersionTables::speciesTable(version);
+        const auto& abilities       = VersionTables::abilityTable(version);
+        const auto& items           = VersionTables::itemTable(version);
+        const auto& balls           = VersionTables::ballTable(version);
+
+        const auto formCount = [version](Species forms)
+        { return VersionTables::formCount(version, forms); };
+
+        bool moveBad = false;
+        for (int i = 0; i < 4; i++)
+        {
+            if (moves.count(pk.move(i)) == 0)
+            {
+                moveBad = true;
+                break;
+            }
+            if (moves.count(pk.relearnMove(i)) == 0)
+            {
+                moveBad = true;
+                break;
+            }
+        }
+        if (moveBad)
+        {
+            return Sav::BadTransferReason::MOVE;
+        }
+        if (species.count(pk.species()) == 0)
+        {
+            return Sav::BadTransferReason::SPECIES;
+        }
+        if (pk.alternativeForm() >= formCount(pk.species()) &&
+            !((pk.species() == Species::Scatterbug || pk.species() == Species::Spewpa) &&
+                pk.alternativeForm() < formCount(Species::Vivillon)) &&
+            !((pk.species() == Species::Mothim) &&
+                pk.alternativeForm() < formCount(Species::Burmy)))
+        {
+            return Sav::BadTransferReason::FORM;
+        }
+        if (abilities.count(pk.ability()) == 0)
+        {
+            if (generation > Generation::TWO && pk.generation() > Generation::TWO)
+            {
+                return Sav::BadTransferReason::ABILITY;
+            }
+        }
+
+        if (generation <= Generation::TWO)
+        {
+            const int heldItem2 = pk.generation() == Generation::ONE
+                                    ? (int)static_cast<const PK1&>(pk).heldItem2()
+                                    : (pk.generation() == Generation::TWO
+                                              ? (int)static_cast<const PK2&>(pk).heldItem2()
+                                              : (int)ItemConverter::nationalToG2(pk.heldItem()));
+            // Crystal only adds key items
+            if (VersionTables::itemTable(GameVersion::GD).count(heldItem2) == 0 ||
+                (heldItem2 == 0 && pk.heldItem() != 0))
+            {
+                return Sav::BadTransferReason::ITEM;
+            }
+        }
+        else if (generation == Generation::THREE)
+        {
+            const int heldItem3 = pk.generation() == Generation::THREE
+                                    ? (int)static_cast<const PK3&>(pk).heldItem3()
+                                    : (int)ItemConverter::nationalToG3(pk.heldItem());
+            if (items.count(heldItem3) == 0 || (heldItem3 == 0 && pk.heldItem() != 0))
+            {
+                return Sav::BadTransferReason::ITEM;
+            }
+        }
+        else if (items.count((int)pk.heldItem()) == 0 ||
+                 (pk.generation() == Generation::THREE &&
+                     pk.heldItem() == ItemConverter::ITEM_NOT_CONVERTIBLE))
+        {
+            return Sav::BadTransferReason::ITEM;
+        }
+
+        if (balls.count(pk.ball()) == 0)
+        {
+            if (generation > Generation::TWO)
+            {
+                return Sav::BadTransferReason::BALL;
+            }
+        }
+        return Sav::BadTransferReason::OKAY;
+    }
+}
+
+#endif
@@ -0,0 +1,143 @@
+/*
+ *   This file is part of PKSM-Core
+ *   Copyright (C) 2016-2022 Bernardo Giordano, Admiral Fish, piepie62, Pk11
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+ *       * Requiring preservation of specified reasonable legal notices or
+ *         author attributions in that material or in the Appropriate Legal
+ *         Notices displayed by works containing it.
+ *       * Prohibiting misrepresentation of the origin of that material,
+ *         or requiring that modified versions of such material be marked in
+ *         reasonable ways as different from the original version.
+ */
+
+#ifndef TESTS_REFERENCE_MOVEPP_HPP
+#define TESTS_REFERENCE_MOVEPP_HPP
+
+#include "../../source/utils/ppCount.hpp"
+#include "enums/Generation.hpp"
+#include "enums/Move.hpp"
+#include <algorithm>
+
+// VersionTables::movePP as it was before the per-generation PP arrays, copied from
+// source/utils/VersionTables.cpp as it was before commit 7b202e5. It searches the same difference
+// lists the arrays are built from
+
+namespace pksm::reference
+{
+    inline u8 movePP(pksm::Generation gen, Move move, u8 ppUps)
+    {
+        if (move == pksm::Move::INVALID || move == pksm::Move::None ||
+            size_t(move) >= internal::PP_G8.size())
+        {
+            return 0;
+        }
+        u8 val = 0;
+        switch (gen)
+        {
+            case pksm::Generation::EIGHT:
+            case pksm::Generation::SEVEN:
+                val = internal::PP_G8[size_t(move)];
+                break;
+            case pksm::Generation::SIX:
+            {
+                auto found = std::find_if(internal::PPDiff_G6.begin(), internal::PPDiff_G6.end(),
+                    [move](const std::pair<pksm::Move, u8>& v) { return v.first == move; });
+                if (found != internal::PPDiff_G6.end())
+                {
+                    val = found->second;
+                }
+                else
+                {
+                    val = internal::PP_G8[size_t(move)];
+                }
+            }
+            break;
+            case pksm::Generation::FIVE:
+            {
+                auto found = std::find_if(internal::PPDiff_G5.begin(), internal::PPDiff_G5.end(),
+                    [move](const std::pair<pksm::Move, u8>& v) { return v.first == move; });
+                if (found != internal::PPDiff_G5.end())
+                {
+                    val = found->second;
+                }
+                else
+                {
+                    val = internal::PP_G8[size_t(move)];
+                }
+            }
+            break;
+            case pksm::Generation::FOUR:
+            {
+                auto found = std::find_if(internal::PPDiff_G4.begin(), internal::PPDiff_G4.end(),
+                    [move](const std::pair<pksm::Move, u8>& v) { return v.first == move; });
+                if (found != internal::PPDiff_G4.end())
+                {
+                    val = found->second;
+                }
+                else
+                {
+                    val = internal::PP_G8[size_t(move)];
+                }
+            }
+            break;
+            // So... no PP changes for Gen I and II moves occurred until Gen IV. Nice.
+            case pksm::Generation::ONE:
+            case pksm::Generation::TWO:
+            case pksm::Generation::THREE:
+            {
+                auto found =
+                    std::find_if(internal::PPDiff_G123.begin(), internal::PPDiff_G123.end(),
+                        [move](const std::pair<pksm::Move, u8>& v) { return v.first == move; });
+                if (found != internal::PPDiff_G123.end())
+                {
+                    val = found->second;
+                }
+                else
+                {
+                    val = internal::PP_G8[size_t(move)];
+                }
+            }
+            break;
+            case pksm::Generation::LGPE:
+            {
+                auto found =
+                    std::find_if(internal::PPDiff_LGPE.begin(), internal::PPDiff_LGPE.end(),
+                        [move](const std::pair<pksm::Move, u8>& v) { return v.first == move; });
+                if (found != internal::PPDiff_LGPE.end())
+                {
+                    val = found->second;
+                }
+                else
+                {
+                    val = internal::PP_G8[size_t(move)];
+                }
+            }
+            break;
+            default:
+                return 0;
+        }
+
+        // Stupid thing G1/2 does: they can't store above 63 for PP value
+        if (gen <= pksm::Generation::TWO && val == 40)
+        {
+            return val + 7 * ppUps;
+        }
+        return val + ((val / 5) * ppUps);
+    }
+}
+
+#endif
@@ -0,0 +1,236 @@
+/*
+ *   This file is part of PKSM-Core
+ *   Copyright (C) 2016-2022 Bernardo Giordano, Admiral Fish, piepie62
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+ *       * Requiring preservation of specified reasonable legal notices or
+ *         author attributions in that material or in the Appropriate Legal
+ *         Notices displayed by works containing it.
+ *       * Prohibiting misrepresentation of the origin of that material,
+ *         or requiring that modified versions of such material be marked in
+ *         reasonable ways as different from the original version.
+ */
+
+// Checks SearchIndex queries against a scan of every party and box slot of the indexed saves,
+// through the in-memory index, its serialized form read in place, and an index loaded back from
+// that, before and after a save is changed and updated and after one is removed
+
+#include "common.hpp"
+#include "sav/SearchIndex.hpp"
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <random>
+#include <tuple>
+
+namespace
+{
+    using Key     = pksm::SearchIndex::Key;
+    using Results = std::vector<std::tuple<u32, u8, u8>>;
+
+    struct Query
+    {
+        std::vector<Key> keys;
+        std::function<bool(const pksm::PKX&)> matches;
+    };
+
+    Results flatten(const std::vector<pksm::SearchIndex::Result>& results)
+    {
+        Results ret;
+        for (const auto& result : results)
+        {
+            ret.emplace_back(result.save, result.where.box, result.where.slot);
+        }
+        return ret;
+    }
+
+    Results scan(const std::map<u32, pksm::Sav*>& saves, const Query& query)
+    {
+        Results ret;
+        for (const auto& [id, sav] : saves)
+        {
+            for (const test::Slot& slot : test::readSlots(*sav))
+            {
+                if (query.matches(*slot.pk))
+                {
+                    ret.emplace_back(id, slot.where.box, slot.where.slot);
+                }
+            }
+        }
+        // Party slots are numbered past every box
+        std::sort(ret.begin(), ret.end());
+        return ret;
+    }
+
+    // Queries built from the Pokemon in a few slots, so that they all find something
+    std::vector<Query> queries(const pksm::Sav& sav)
+    {
+        std::vector<Query> ret;
+        ret.push_back({{}, [](const pksm::PKX&) { return false; }});
+        ret.push_back({{Key::shiny()}, [](const pksm::PKX& pk) { return pk.shiny(); }});
+        ret.push_back({{Key::gigantamax()}, [](const pksm::PKX&) { return false; }});
+        for (int i : {0, 31, 95, 200})
+        {
+            auto pk = sav.pkm(i / 30, i % 30);
+            if (pk->species() == pksm::Species::None)
+            {
+                continue;
+            }
+            const pksm::Species species = pk->species();
+            const u16 form              = pk->alternativeForm();
+            const pksm::Ball ball       = pk->ball();
+            const u16 tid = pk->TID(), sid = pk->SID();
+            const u32 pid = pk->PID(), ec = pk->encryptionConstant();
+
+            auto isSpecies = [=](const pksm::PKX& other)
+            { return other.species() == species && other.alternativeForm() == form; };
+            auto isTrainer = [=](const pksm::PKX& other)
+            { return other.TID() == tid && other.SID() == sid; };
+            ret.push_back({{Key::species(species, form)}, isSpecies});
+            ret.push_back({{Key::trainer(tid, sid), Key::ball(ball)},
+                [=](const pksm::PKX& other) { return isTrainer(other) && other.ball() == ball; }});
+            ret.push_back({{Key::species(species, form), Key::trainer(tid, sid), Key::shiny()},
+                [=](const pksm::PKX& other)
+                { return isSpecies(other) && isTrainer(other) && other.shiny(); }});
+            if (sav.generation() != pksm::Generation::ONE)
+            {
+                ret.push_back({{Key::PID(pid)},
+                    [=](const pksm::PKX& other)
+                    {
+                        return other.generation() >= pksm::Generation::THREE && other.PID() == pid;
+                    }});
+                ret.push_back({{Key::encryptionConstant(ec), Key::species(species, form)},
+                    [=](const pksm::PKX& other)
+                    {
+                        return other.generation() >= pksm::Generation::THREE &&
+                               other.encryptionConstant() == ec && isSpecies(other);
+                    }});
+            }
+        }
+        // A key nobody has empties any query it is part of
+        ret.push_back({{Key::species(pksm::Species::None, 0), Key::shiny()},
+            [](const pksm::PKX&) { return false; }});
+        return ret;
+    }
+
+    // Gives the boxed Pokemon a spread of balls and shininess, and copies a few into the party
+    void vary(pksm::Sav& sav, u32 seed)
+    {
+        std::mt19937 rng(seed);
+        test::fillBoxes(sav, seed);
+        sav.editEachPKM(
+            [&rng](pksm::PKX& pk, pksm::Sav::StorageSlot)
+            {
+                pk.ball(pksm::Ball{u8(1 + rng() % 4)});
+                pk.shiny(rng() % 8 == 0);
+                pk.refreshChecksum();
+                return true;
+            });
+        for (u8 slot = 0; slot < 3; slot++)
+        {
+            sav.pkm(*sav.pkm(1, slot), slot);
+        }
+        sav.partyCount(3);
+    }
+
+    int compare(const pksm::SearchIndex& index, const std::map<u32, pksm::Sav*>& saves,
+        const std::vector<Query>& all)
+    {
+        const std::vector<u8> bytes = index.serialize();
+        std::shared_ptr<u8[]> copy(new u8[bytes.size()]);
+        std::copy(bytes.begin(), bytes.end(), copy.get());
+        const pksm::SearchIndex::View view(copy, bytes.size());
+        CHECK(view.valid());
+        const pksm::SearchIndex loaded(view);
+        CHECK(loaded.serialize() == bytes);
+
+        int found = 0;
+        for (const Query& query : all)
+        {
+            const Results expected = scan(saves, query);
+            CHECK(flatten(index.query(query.keys)) == expected);
+            CHECK(flatten(view.query(query.keys)) == expected);
+            CHECK(flatten(loaded.query(query.keys)) == expected);
+            found += expected.size();
+        }
+        return found;
+    }
+}
+
+int main()
+{
+    auto gen1 = test::blankSave(0x8000);
+    auto gen3 = test::blankGen3();
+    auto lgpe = test::blankSave(0xB8800);
+    lgpe->version(pksm::GameVersion::GP);
+    auto swsh = test::blankSWSH();
+    vary(*gen1, 1);
+    vary(*gen3, 3);
+    vary(*lgpe, 7);
+    vary(*swsh, 8);
+
+    // IDs are the caller's, and need not be small or dense
+    std::map<u32, pksm::Sav*> saves = {
+        {1, gen1.get()}, {3, gen3.get()}, {70000, lgpe.get()}, {0xFFFFFFFF, swsh.get()}};
+    pksm::SearchIndex index;
+    for (const auto& [id, sav] : saves)
+    {
+        index.update(id, *sav);
+    }
+
+    std::vector<Query> all;
+    for (const auto& [id, sav] : saves)
+    {
+        std::vector<Query> some = queries(*sav);
+        all.insert(all.end(), some.begin(), some.end());
+    }
+    const int found = compare(index, saves, all);
+    CHECK(found > 0);
+    std::printf("  %zu queries over %zu saves, %d results\n", all.size(), saves.size(), found);
+
+    // Moving, editing and removing Pokemon shows up once the save is updated
+    auto moved = gen3->pkm(0, 0);
+    gen3->pkm(*gen3->emptyPkm(), 0, 0, false);
+    moved->shiny(true);
+    moved->refreshChecksum();
+    gen3->pkm(*moved, 13, 29, false);
+    gen3->pkm(*gen3->emptyPkm(), 2, 5, false);
+    index.update(3, *gen3);
+    compare(index, saves, all);
+
+    index.remove(70000);
+    saves.erase(70000);
+    compare(index, saves, all);
+
+    // Anything that isn't a whole index is refused
+    const std::vector<u8> bytes = index.serialize();
+    std::shared_ptr<u8[]> copy(new u8[bytes.size()]);
+    std::copy(bytes.begin(), bytes.end(), copy.get());
+    CHECK(pksm::SearchIndex::View(copy, bytes.size()).valid());
+    CHECK(!pksm::SearchIndex::View(copy, bytes.size() - 8).valid());
+    copy[0] ^= 1;
+    CHECK(!pksm::SearchIndex::View(copy, bytes.size()).valid());
+
+    // Nothing left is the same as nothing indexed
+    for (const auto& [id, sav] : saves)
+    {
+        index.remove(id);
+    }
+    CHECK(index.serialize() == pksm::SearchIndex().serialize());
+    CHECK(index.query({Key::shiny()}).empty());
+
+    return test::finish("search_index");
+}
@@ -0,0 +1,232 @@
+/*
+ *   This file is part of PKSM-Core
+ *   Copyright (C) 2016-2022 Bernardo Giordano, Admiral Fish, piepie62
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+ *       * Requiring preservation of specified reasonable legal notices or
+ *         author attributions in that material or in the Appropriate Legal
+ *         Notices displayed by works containing it.
+ *       * Prohibiting misrepresentation of the origin of that material,
+ *         or requiring that modified versions of such material be marked in
+ *         reasonable ways as different from the original version.
+ */
+
+// Checks Sav::transferMany against checking, converting and writing the same Pokemon one at a
+// time, and that after seedRand it gives the same results and the same save for any number of
+// threads
+
+#include "common.hpp"
+#include "utils/executor.hpp"
+#include "utils/random.hpp"
+#include <algorithm>
+#include <functional>
+#include <limits>
+
+namespace
+{
+    using Make    = std::function<std::unique_ptr<pksm::Sav>()>;
+    using Results = std::vector<pksm::Sav::TransferResult>;
+
+    constexpr u32 SEED = 46;
+
+    Make blank(size_t length, pksm::GameVersion version)
+    {
+        return [=]
+        {
+            auto sav = test::blankSave(length);
+            sav->version(version);
+            return sav;
+        };
+    }
+
+    // The target's boxes are filled, then emptied from the end until only free slots are left
+    std::unique_ptr<pksm::Sav> target(const Make& make, int free)
+    {
+        auto sav = make();
+        test::fillBoxes(*sav, 4, true);
+        for (int i = sav->maxSlot() - 1; i >= sav->maxSlot() - free; i--)
+        {
+            sav->pkm(*sav->emptyPkm(), i / 30, i % 30, false);
+        }
+        return sav;
+    }
+
+    u32 draw()
+    {
+        return pksm::randomNumber(0, std::numeric_limits<u32>::max());
+    }
+
+    // transferMany's contract, one Pokemon at a time: every conversion is seeded from the
+    // caller's generator, the checks are invalidTransferReason's, and the Pokemon that pass go
+    // to the free slots in order
+    Results oneByOne(pksm::Sav& sav, const std::vector<const pksm::PKX*>& pks)
+    {
+        pksm::seedRand(SEED);
+        std::vector<u32> seeds(pks.size());
+        for (u32& seed : seeds)
+        {
+            seed = draw();
+        }
+
+        Results ret;
+        int slot = sav.firstFreeSlot();
+        for (size_t i = 0; i < pks.size(); i++)
+        {
+            pksm::Sav::TransferResult& result =
+                ret.emplace_back(sav.invalidTransferReason(*pks[i]), -1);
+            if (result.reason != pksm::Sav::BadTransferReason::OKAY)
+            {
+                continue;
+            }
+            pksm::seedRand(seeds[i]);
+            auto converted = sav.transfer(*pks[i]);
+            if (!converted)
+            {
+                result.reason = pksm::Sav::BadTransferReason::CONVERSION;
+            }
+            else if (slot != -1)
+            {
+                sav.pkm(*converted, slot / 30, slot % 30, false);
+                result.slot = slot;
+                slot        = sav.firstFreeSlot(slot + 1);
+            }
+        }
+        // The caller's generator only moves on by the draws for the seeds
+        pksm::seedRand(SEED);
+        for (size_t i = 0; i < seeds.size(); i++)
+        {
+            (void)draw();
+        }
+        return ret;
+    }
+
+    Results many(pksm::Sav& sav, const std::vector<const pksm::PKX*>& pks, bool applyTrade,
+        size_t threads)
+    {
+        pksm::seedRand(SEED);
+        return sav.transferMany(pks, applyTrade, threads);
+    }
+
+    bool same(const Results& a, const Results& b)
+    {
+        return std::ranges::equal(a, b,
+            [](const auto& x, const auto& y) { return x.reason == y.reason && x.slot == y.slot; });
+    }
+
+    bool sameBytes(pksm::Sav& a, pksm::Sav& b)
+    {
+        a.finishEditing();
+        b.finishEditing();
+        return a.getLength() == b.getLength() &&
+               std::equal(a.rawData().get(), a.rawData().get() + a.getLength(), b.rawData().get());
+    }
+
+    void check(const char* name, const Make& make, const std::vector<const pksm::PKX*>& pks,
+        int free)
+    {
+        auto expectedSav       = target(make, free);
+        const Results expected = oneByOne(*expectedSav, pks);
+        const u32 next         = draw();
+
+        size_t okay = 0, written = 0;
+        for (const auto& result : expected)
+        {
+            okay    += result.reason == pksm::Sav::BadTransferReason::OKAY;
+            written += result.slot != -1;
+        }
+        CHECK(okay > 0 && okay < pks.size());
+        CHECK(written == std::min<size_t>(okay, free));
+
+        for (size_t threads : {1, 4})
+        {
+            auto sav = target(make, free);
+            CHECK(same(many(*sav, pks, false, threads), expected));
+            CHECK(draw() == next);
+            CHECK(sameBytes(*sav, *expectedSav));
+        }
+
+        // Trading draws from the generator too, and still comes out the same
+        auto traded           = target(make, free);
+        const Results tradeds = many(*traded, pks, true, 1);
+        const u32 tradedNext  = draw();
+        for (size_t threads : {2, 3, 8})
+        {
+            auto sav = target(make, free);
+            CHECK(same(many(*sav, pks, true, threads), tradeds));
+            CHECK(draw() == tradedNext);
+            CHECK(sameBytes(*sav, *traded));
+        }
+
+        std::printf("  %s: %zu Pokemon, %zu pass, %zu written\n", name, pks.size(), okay, written);
+    }
+}
+
+int main()
+{
+#ifndef _PKSMCORE_DISABLE_THREAD_SAFETY
+    // Workers of their own even with one core, so that conversions really run on other threads
+    pksm::executor(std::make_shared<pksm::ThreadPool>(3));
+#endif
+
+    // Whatever a thread's generator is reseeded to under a guard, it carries on as before after
+    pksm::seedRand(SEED);
+    const u32 first = draw(), second = draw();
+    pksm::seedRand(SEED);
+    CHECK(draw() == first);
+    {
+        pksm::RandomStateGuard guard;
+        pksm::seedRand(SEED + 1);
+        CHECK(draw() != second);
+    }
+    CHECK(draw() == second);
+
+    // Pokemon from every kind of save that can be made from scratch
+    const std::pair<Make, u32> sources[] = {
+        {[] { return test::blankSave(0x8000); }, 1},
+        {test::blankGen3, 3},
+        {blank(0x65600, pksm::GameVersion::X), 6},
+        {blank(0x6BE00, pksm::GameVersion::SN), 7},
+        {blank(0xB8800, pksm::GameVersion::GP), 70},
+        {test::blankSWSH, 8},
+    };
+    std::vector<std::unique_ptr<pksm::PKX>> owned;
+    for (const auto& [make, seed] : sources)
+    {
+        auto sav = make();
+        test::fillBoxes(*sav, seed);
+        std::vector<test::Slot> slots = test::readSlots(*sav);
+        for (size_t i = 0; i < slots.size() && i < 40; i++)
+        {
+            // fillBoxes leaves the ball empty, which no game accepts
+            slots[i].pk->ball(pksm::Ball::Poke);
+            slots[i].pk->refreshChecksum();
+            owned.push_back(std::move(slots[i].pk));
+        }
+    }
+    std::vector<const pksm::PKX*> pks;
+    for (const auto& pk : owned)
+    {
+        pks.push_back(pk.get());
+    }
+
+    const Make sm = blank(0x6BE00, pksm::GameVersion::SN);
+    check("SM", sm, pks, 200);
+    check("SM, 5 free slots", sm, pks, 5);
+    check("SwSh", test::blankSWSH, pks, 200);
+    check("SwSh, 5 free slots", test::blankSWSH, pks, 5);
+
+    return test::finish("transfer_many");
+}
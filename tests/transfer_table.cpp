@@ -0,0 +1,149 @@
+/*
+ *   This file is part of PKSM-Core
+ *   Copyright (C) 2016-2022 Bernardo Giordano, Admiral Fish, piepie62
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+ *       * Requiring preservation of specified reasonable legal notices or
+ *         author attributions in that material or in the Appropriate Legal
+ *         Notices displayed by works containing it.
+ *       * Prohibiting misrepresentation of the origin of that material,
+ *         or requiring that modified versions of such material be marked in
+ *         reasonable ways as different from the original version.
+ */
+
+// Checks TransferTable against invalidTransferReason as it was before the tables, for Pokemon from
+// every kind of save with one field at a time made random, and every value a GameVersion can hold
+
+#include "common.hpp"
+#include "reference/invalidTransferReason.hpp"
+#include "sav/TransferTable.hpp"
+#include "utils/random.hpp"
+#include <array>
+#include <functional>
+
+namespace
+{
+    using Make   = std::function<std::unique_ptr<pksm::Sav>()>;
+    using Reason = pksm::Sav::BadTransferReason;
+
+    Make blank(size_t length, pksm::GameVersion version)
+    {
+        return [=]
+        {
+            auto sav = test::blankSave(length);
+            sav->version(version);
+            return sav;
+        };
+    }
+
+    pksm::Move randomMove() { return pksm::Move{u16(pksm::randomNumber(0, 1000))}; }
+
+    // Each makes one field random, so that the Pokemon doesn't just fail on its moves
+    const std::function<void(pksm::PKX&)> mutations[] = {
+        [](pksm::PKX&) {},
+        [](pksm::PKX& pk) { pk.move(pksm::randomNumber(0, 3), randomMove()); },
+        [](pksm::PKX& pk) { pk.relearnMove(pksm::randomNumber(0, 3), randomMove()); },
+        [](pksm::PKX& pk) { pk.species(pksm::Species{u16(pksm::randomNumber(1, 1000))}); },
+        [](pksm::PKX& pk) { pk.alternativeForm(pksm::randomNumber(0, 30)); },
+        [](pksm::PKX& pk) { pk.ability(pksm::Ability{u16(pksm::randomNumber(0, 300))}); },
+        [](pksm::PKX& pk) { pk.heldItem(u16(pksm::randomNumber(0, 2100))); },
+        [](pksm::PKX& pk) { pk.ball(pksm::Ball{u8(pksm::randomNumber(0, 30))}); },
+    };
+
+    // Forms that only exist once the Pokemon evolves, which the old check let through
+    void addEvolvedForms(const pksm::PKX& base, std::vector<std::unique_ptr<pksm::PKX>>& out)
+    {
+        const pksm::Species species[] = {
+            pksm::Species::Scatterbug, pksm::Species::Spewpa, pksm::Species::Mothim};
+        for (const pksm::Species& evolves : species)
+        {
+            for (u16 form = 0; form < 22; form++)
+            {
+                auto pk = base.clone();
+                pk->species(evolves);
+                pk->alternativeForm(form);
+                out.push_back(std::move(pk));
+            }
+        }
+    }
+}
+
+int main()
+{
+    // Pokemon from every kind of save that can be made from scratch
+    const std::pair<Make, u32> sources[] = {
+        {[] { return test::blankSave(0x8000); }, 1},
+        {test::blankGen3, 3},
+        {blank(0x65600, pksm::GameVersion::X), 6},
+        {blank(0x76000, pksm::GameVersion::OR), 61},
+        {blank(0x6BE00, pksm::GameVersion::SN), 7},
+        {blank(0x6CC00, pksm::GameVersion::US), 71},
+        {blank(0xB8800, pksm::GameVersion::GP), 70},
+        {test::blankSWSH, 8},
+    };
+    std::vector<std::unique_ptr<pksm::PKX>> pks;
+    for (const auto& [make, seed] : sources)
+    {
+        auto sav = make();
+        test::fillBoxes(*sav, seed);
+        std::vector<test::Slot> slots = test::readSlots(*sav);
+        for (size_t i = 0; i < slots.size() && i < 30; i++)
+        {
+            // fillBoxes leaves the ball empty, which no game accepts
+            slots[i].pk->ball(pksm::Ball::Poke);
+            for (const auto& mutate : mutations)
+            {
+                auto pk = slots[i].pk->clone();
+                mutate(*pk);
+                pks.push_back(std::move(pk));
+            }
+        }
+        if (!slots.empty())
+        {
+            addEvolvedForms(*slots.front().pk, pks);
+        }
+    }
+
+    std::array<size_t, size_t(Reason::CONVERSION) + 1> reasons{};
+    size_t versions = 0;
+    for (int v = 0; v < 256; v++)
+    {
+        const pksm::GameVersion version{u8(v)};
+        if (pksm::Generation(version) == pksm::Generation::UNUSED)
+        {
+            continue;
+        }
+        versions++;
+        for (const auto& pk : pks)
+        {
+            const Reason expected = pksm::reference::invalidTransferReason(*pk, version);
+            CHECK(pksm::TransferTable::get(pk->generation(), version).check(*pk) == expected);
+            reasons[size_t(expected)]++;
+        }
+    }
+    // Every check is reached at least once
+    for (size_t reason = 0; reason < size_t(Reason::CONVERSION); reason++)
+    {
+        CHECK(reasons[reason] > 0);
+    }
+
+    std::printf("  %zu Pokemon, %zu versions: %zu okay, %zu move, %zu species, %zu form, "
+                "%zu ability, %zu item, %zu ball\n",
+        pks.size(), versions, reasons[0], reasons[1], reasons[2], reasons[3], reasons[4],
+        reasons[5], reasons[6]);
+
+    return test::finish("transfer_table");
+}
@@ -0,0 +1,85 @@
+/*
+ *   This file is part of PKSM-Core
+ *   Copyright (C) 2016-2022 Bernardo Giordano, Admiral Fish, piepie62
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+ *       * Requiring preservation of specified reasonable legal notices or
+ *         author attributions in that material or in the Appropriate Legal
+ *         Notices displayed by works containing it.
+ *       * Prohibiting misrepresentation of the origin of that material,
+ *         or requiring that modified versions of such material be marked in
+ *         reasonable ways as different from the original version.
+ */
+
+// Checks every VersionTables bitset, and the std::set built from it, against the std::set tables
+// they replaced, for every value a GameVersion can hold
+
+#include "common.hpp"
+#include "reference/VersionTables.hpp"
+#include "utils/VersionTables.hpp"
+
+namespace
+{
+    template <typename T, size_t N>
+    void compare(const pksm::VersionTables::IdSet<T, N>& table, const std::set<T>& available,
+        const std::set<T>& reference)
+    {
+        CHECK(std::set<T>(table.begin(), table.end()) == reference);
+        CHECK(table.size() == reference.size());
+        CHECK(table.empty() == reference.empty());
+        CHECK(available == reference);
+        for (size_t id = 0; id < N; id++)
+        {
+            CHECK(table.contains(T(id)) == (reference.count(T(id)) > 0));
+        }
+        // Nothing past the end of the table is in it
+        for (const T& id : reference)
+        {
+            CHECK(size_t(id) < N);
+        }
+    }
+}
+
+int main()
+{
+    namespace VersionTables = pksm::VersionTables;
+    namespace reference     = pksm::reference;
+
+    size_t ids = 0;
+    for (int v = 0; v < 256; v++)
+    {
+        const pksm::GameVersion version{u8(v)};
+        compare(VersionTables::itemTable(version), VersionTables::availableItems(version),
+            reference::availableItems(version));
+        compare(VersionTables::moveTable(version), VersionTables::availableMoves(version),
+            reference::availableMoves(version));
+        compare(VersionTables::speciesTable(version), VersionTables::availableSpecies(version),
+            reference::availableSpecies(version));
+        compare(VersionTables::abilityTable(version), VersionTables::availableAbilities(version),
+            reference::availableAbilities(version));
+        compare(VersionTables::ballTable(version), VersionTables::availableBalls(version),
+            reference::availableBalls(version));
+        ids += reference::availableItems(version).size() +
+               reference::availableMoves(version).size() +
+               reference::availableSpecies(version).size() +
+               reference::availableAbilities(version).size() +
+               reference::availableBalls(version).size();
+    }
+    CHECK(ids > 0);
+    std::printf("  256 versions, %zu IDs\n", ids);
+
+    return test::finish("version_tables");
+}
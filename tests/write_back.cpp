@@ -0,0 +1,130 @@
+/*
+ *   This file is part of PKSM-Core
+ *   Copyright (C) 2016-2022 Bernardo Giordano, Admiral Fish, piepie62
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+ *       * Requiring preservation of specified reasonable legal notices or
+ *         author attributions in that material or in the Appropriate Legal
+ *         Notices displayed by works containing it.
+ *       * Prohibiting misrepresentation of the origin of that material,
+ *         or requiring that modified versions of such material be marked in
+ *         reasonable ways as different from the original version.
+ */
+
+// Checks that writeBack leaves a file holding exactly the edited save, whether that is the file
+// the save was mapped from, another save of the same size, or a file that doesn't exist yet
+
+#include "common.hpp"
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iterator>
+
+namespace
+{
+    using Make = std::function<std::unique_ptr<pksm::Sav>()>;
+
+    Make blank(size_t length, pksm::GameVersion version)
+    {
+        return [=]
+        {
+            auto sav = test::blankSave(length);
+            sav->version(version);
+            return sav;
+        };
+    }
+
+    std::vector<u8> bytes(pksm::Sav& sav)
+    {
+        return std::vector<u8>(sav.rawData().get(), sav.rawData().get() + sav.getLength());
+    }
+
+    std::vector<u8> read(const std::filesystem::path& path)
+    {
+        std::ifstream in(path, std::ios::binary);
+        return std::vector<u8>(std::istreambuf_iterator<char>(in), {});
+    }
+
+    void write(const std::filesystem::path& path, const std::vector<u8>& data)
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(data.data()), data.size());
+    }
+
+    // A filled save, as its file would hold it
+    std::vector<u8> image(const Make& make, u32 seed)
+    {
+        auto sav = make();
+        test::fillBoxes(*sav, seed);
+        sav->finishEditing();
+        return bytes(*sav);
+    }
+
+    void check(const char* name, const Make& make)
+    {
+        const std::filesystem::path dir = std::filesystem::temp_directory_path();
+        const std::filesystem::path mappedPath = dir / "pksm_write_back_mapped.sav";
+        const std::filesystem::path otherPath  = dir / "pksm_write_back_other.sav";
+        const std::filesystem::path newPath    = dir / "pksm_write_back_new.sav";
+        const std::vector<u8> other            = image(make, 2);
+        write(mappedPath, image(make, 1));
+        write(otherPath, other);
+        std::filesystem::remove(newPath);
+
+        // One Pokemon moved, so most pages of the mapping are never written
+        auto sav = pksm::Sav::getSave(mappedPath.string());
+        CHECK(sav != nullptr);
+        if (!sav)
+        {
+            return;
+        }
+        sav->pkm(*sav->pkm(0, 1), 0, 0, false);
+        sav->finishEditing();
+        const std::vector<u8> expected = bytes(*sav);
+        CHECK(expected.size() == other.size());
+
+        CHECK(sav->writeBack(otherPath.string()));
+        CHECK(read(otherPath) == expected);
+        CHECK(sav->writeBack(newPath.string()));
+        CHECK(read(newPath) == expected);
+        CHECK(sav->writeBack());
+        CHECK(read(mappedPath) == expected);
+
+        size_t pages = 0;
+        for (size_t i = 0; i < expected.size(); i += 0x1000)
+        {
+            pages += !std::equal(expected.begin() + i,
+                expected.begin() + std::min(i + 0x1000, expected.size()), other.begin() + i);
+        }
+        std::printf("  %s: %zu bytes, %zu pages differ from the other save\n", name,
+            expected.size(), pages);
+
+        sav.reset();
+        for (const auto& path : {mappedPath, otherPath, newPath})
+        {
+            std::filesystem::remove(path);
+        }
+    }
+}
+
+int main()
+{
+    check("Gen I", [] { return test::blankSave(0x8000); });
+    check("SM", blank(0x6BE00, pksm::GameVersion::SN));
+    check("SwSh", test::blankSWSH);
+
+    return test::finish("write_back");
+}